@@ -0,0 +1,124 @@
+/**
+ * @file address_table_bench.cpp
+ *
+ * @brief Benchmark of the address to receiver lookup with 10, 1k and 100k registered receivers
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Project Includes
+#include "address_table.hpp"
+#include "bench_support.hpp"
+#include "ethernet_driver.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr std::size_t LOOKUPS = 1 << 20;
+    constexpr std::size_t FORWARDED_FRAMES = 1 << 18;
+    constexpr std::size_t PAYLOAD_SIZE = 64;
+
+    // Takes every frame and does nothing with it
+    class NullReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t *, std::size_t) override {}
+            void receiveFrames(std::span<const FrameRef>) override {}
+    };
+
+    /**
+     * @brief Store and forward frames to the given destinations, a queue full at a time
+     *
+     * @return double: nanoseconds per forwarded frame
+     */
+    double forwardTo(EthernetDriver& driver, const std::vector<uint32_t>& destinations) {
+
+        // Initialize method variables
+        std::vector<uint8_t> frames(destinations.size() * (EthernetFrame::HEADER_SIZE + PAYLOAD_SIZE), 0);
+        std::size_t frameSize = EthernetFrame::HEADER_SIZE + PAYLOAD_SIZE;
+
+        for (std::size_t i = 0; i < destinations.size(); ++i) {
+            EthernetFrame::writeHeader(frames.data() + i * frameSize, FrameHeaderSchema::addressToBytes(destinations[i]),
+                                       {0x0A, 0x0B, 0x0C, 0x0D}, PAYLOAD_SIZE);
+        }
+
+        return Bench::bestNanosecondsPer(FORWARDED_FRAMES, [&] {
+            for (std::size_t sent = 0; sent < FORWARDED_FRAMES; ) {
+                for (std::size_t i = 0; i < EthernetDriver::MAX_BUFFERED_FRAMES; ++i, ++sent) {
+                    driver.storeSerializedFrame(frames.data() + (sent % destinations.size()) * frameSize, frameSize);
+                }
+                driver.processStoredFrame();
+            }
+        });
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    const std::array<std::size_t, 3> receiverCounts = {10, 1000, 100000};
+    NullReceiver receiver;
+
+    std::printf("Address to receiver lookup, %zu random lookups per run\n", LOOKUPS);
+
+    for (std::size_t receivers : receiverCounts) {
+        std::mt19937 random(1);
+        std::vector<uint32_t> addresses(receivers);
+        std::vector<uint32_t> lookups(LOOKUPS);
+        std::unordered_map<uint32_t, PacketReceiver*> map;
+        AddressTable<PacketReceiver*> table;
+        char variant[64];
+
+        for (uint32_t& address : addresses) {
+            address = static_cast<uint32_t>(random());
+            map[address] = &receiver;
+            table.insert(address) = &receiver;
+        }
+        for (uint32_t& address : lookups) {
+            address = addresses[random() % receivers];
+        }
+
+        // What forwardSerializedFrame used before: a node based hash map
+        double mapLookup = Bench::bestNanosecondsPer(LOOKUPS, [&] {
+            uintptr_t found = 0;
+            for (uint32_t address : lookups) {
+                found += reinterpret_cast<uintptr_t>(map.find(address)->second);
+            }
+            Bench::keep(found);
+        });
+        double tableLookup = Bench::bestNanosecondsPer(LOOKUPS, [&] {
+            uintptr_t found = 0;
+            for (uint32_t address : lookups) {
+                found += reinterpret_cast<uintptr_t>(*table.find(address));
+            }
+            Bench::keep(found);
+        });
+
+        std::snprintf(variant, sizeof(variant), "%zu receivers unordered_map", receivers);
+        Bench::report("address_table", variant, mapLookup, "ns/lookup");
+        std::snprintf(variant, sizeof(variant), "%zu receivers flat table", receivers);
+        Bench::report("address_table", variant, tableLookup, "ns/lookup");
+
+        // The whole forwarding path: a run to one destination hits the last destination cache
+        EthernetDriver driver;
+        for (uint32_t address : addresses) {
+            driver.registerReceiver(address, &receiver);
+        }
+        std::vector<uint32_t> sameDestination(1, addresses[0]);
+        std::vector<uint32_t> randomDestinations(lookups.begin(), lookups.begin() + 4096);
+
+        std::snprintf(variant, sizeof(variant), "%zu receivers forward, one destination", receivers);
+        Bench::report("address_table", variant, forwardTo(driver, sameDestination), "ns/frame");
+        std::snprintf(variant, sizeof(variant), "%zu receivers forward, random", receivers);
+        Bench::report("address_table", variant, forwardTo(driver, randomDestinations), "ns/frame");
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file batch_receive_bench.cpp
+ *
+ * @brief Benchmark of batch frame delivery into a receiver's rx buffer against per frame delivery into a growing vector
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "ethernet_driver.hpp"
+#include "frame_header_schema.hpp"
+#include "host.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr uint32_t HOST_ADDRESS = 0x01020304;
+    constexpr uint32_t VECTOR_ADDRESS = 0x0A0B0C0D;
+    constexpr uint32_t SOURCE_ADDRESS = 0x05060708;
+    constexpr std::size_t BURSTS = 200000;
+
+    /**
+     * @brief Receiver built the way Host was before batch delivery: every frame
+     * arrives in its own virtual call, is copied into a full size array and
+     * pushed onto a vector, which is cleared (keeping its capacity) per burst
+     */
+    class VectorReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t *data, std::size_t size) override {
+                std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE> frame;
+                std::memcpy(frame.data(), data, size);
+                rxBuffer.push_back(frame);
+            }
+
+            std::size_t size() const { return rxBuffer.size(); }
+            void clear() { rxBuffer.clear(); }
+
+        private:
+            std::vector<std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE>> rxBuffer;
+    };
+
+    std::vector<uint8_t> buildFrame(uint32_t destination) {
+
+        // Initialize method variables
+        std::vector<uint8_t> frame(EthernetFrame::HEADER_SIZE + EthernetFrame::MAX_PAYLOAD_SIZE, 0x5A);
+
+        EthernetFrame::writeHeader(frame.data(), FrameHeaderSchema::addressToBytes(destination),
+                                   FrameHeaderSchema::addressToBytes(SOURCE_ADDRESS),
+                                   static_cast<uint16_t>(EthernetFrame::MAX_PAYLOAD_SIZE));
+        return frame;
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    constexpr std::size_t BURST = Host::MAX_PACKETS;
+    EthernetDriver driver;
+    Host host(&driver, HOST_ADDRESS);
+    VectorReceiver vectorReceiver;
+    std::vector<uint8_t> hostFrame = buildFrame(HOST_ADDRESS);
+    std::vector<uint8_t> vectorFrame = buildFrame(VECTOR_ADDRESS);
+    std::vector<FrameRef> burst(BURST, FrameRef{hostFrame.data(), hostFrame.size()});
+    PacketReceiver* hostReceiver = &host;
+    std::size_t received = 0;
+
+    driver.registerReceiver(VECTOR_ADDRESS, &vectorReceiver);
+
+    std::printf("Bursts of %zu full size frames (%zu byte max payload, Host::MAX_PACKETS)\n",
+                BURST, EthernetFrame::MAX_PAYLOAD_SIZE);
+
+    // The receivers alone: one virtual call and one copy per frame against one call taking the burst
+    double perFrameVector = Bench::bestNanosecondsPer(BURSTS * BURST, [&] {
+        PacketReceiver* receiver = &vectorReceiver;
+        for (std::size_t round = 0; round < BURSTS; ++round) {
+            for (const FrameRef& frame : burst) {
+                receiver->receiveFrame(frame.data, frame.size);
+            }
+            received += vectorReceiver.size();
+            vectorReceiver.clear();
+        }
+        Bench::keep(received);
+    });
+    double perFrameHost = Bench::bestNanosecondsPer(BURSTS * BURST, [&] {
+        for (std::size_t round = 0; round < BURSTS; ++round) {
+            for (const FrameRef& frame : burst) {
+                hostReceiver->receiveFrame(frame.data, frame.size);
+            }
+            host.clearRxBuffer();
+        }
+    });
+    double batchedHost = Bench::bestNanosecondsPer(BURSTS * BURST, [&] {
+        for (std::size_t round = 0; round < BURSTS; ++round) {
+            hostReceiver->receiveFrames(burst);
+            host.clearRxBuffer();
+        }
+    });
+
+    Bench::report("batch_receive", "vector, frame by frame", perFrameVector, "ns/frame");
+    Bench::report("batch_receive", "Host, frame by frame", perFrameHost, "ns/frame");
+    Bench::report("batch_receive", "Host, one batch", batchedHost, "ns/frame");
+    Bench::report("batch_receive", "batch speedup over vector", perFrameVector / batchedHost, "x");
+
+    // Through the driver: store a burst, drain it with one service pass and empty the rx buffer
+    double drainedVector = Bench::bestNanosecondsPer(BURSTS * BURST, [&] {
+        for (std::size_t round = 0; round < BURSTS; ++round) {
+            for (std::size_t i = 0; i < BURST; ++i) {
+                driver.storeSerializedFrame(vectorFrame.data(), vectorFrame.size());
+            }
+            driver.processStoredFrame();
+            received += vectorReceiver.size();
+            vectorReceiver.clear();
+        }
+        Bench::keep(received);
+    });
+    double drainedHost = Bench::bestNanosecondsPer(BURSTS * BURST, [&] {
+        for (std::size_t round = 0; round < BURSTS; ++round) {
+            for (std::size_t i = 0; i < BURST; ++i) {
+                driver.storeSerializedFrame(hostFrame.data(), hostFrame.size());
+            }
+            driver.processStoredFrame();
+            host.clearRxBuffer();
+        }
+    });
+
+    if (driver.hasStoredFrames()) {
+        std::printf("batch_receive: a service pass left frames in the driver\n");
+        return 1;
+    }
+    Bench::report("batch_receive", "driver to vector receiver", drainedVector, "ns/frame");
+    Bench::report("batch_receive", "driver to Host", drainedHost, "ns/frame");
+    Bench::report("batch_receive", "driver speedup", drainedVector / drainedHost, "x");
+
+    return 0;
+}
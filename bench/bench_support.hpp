@@ -0,0 +1,66 @@
+/**
+ * @file bench_support.hpp
+ *
+ * @brief Timing and reporting helpers shared by the microbenchmarks
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_BENCH_SUPPORT_HPP__
+#define EDS_BENCH_SUPPORT_HPP__
+
+// Standard Includes
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+// Declare namespace
+namespace EthernetDriverSimulation::Bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Keep the compiler from dropping a result only the benchmark looks at
+     */
+    template <typename Value>
+    inline void keep(const Value& value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    /**
+     * @brief Run a benchmark body several times and keep the fastest run, which
+     * is the one least disturbed by the rest of the machine
+     *
+     * @param[in] operations - size_t: operations one call of run performs
+     * @param[in] run - callable: the measured body
+     * @param[in] repeats - int: runs to take the best of
+     *
+     * @return double: nanoseconds per operation of the fastest run
+     */
+    template <typename Run>
+    double bestNanosecondsPer(std::size_t operations, Run&& run, int repeats = 5) {
+
+        // Initialize method variables
+        double best = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < repeats; ++i) {
+            Clock::time_point start = Clock::now();
+            run();
+            std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count() / static_cast<double>(operations));
+        }
+        return best;
+    }
+
+    /**
+     * @brief Print one result line: benchmark, case, value and unit
+     */
+    inline void report(const char* benchmark, const char* variant, double value, const char* unit) {
+        std::printf("%-24s %-36s %12.2f %s\n", benchmark, variant, value, unit);
+    }
+};
+
+#endif // EDS_BENCH_SUPPORT_HPP__
@@ -0,0 +1,171 @@
+/**
+ * @file driver_statistics_bench.cpp
+ *
+ * @brief Benchmark of statistics snapshots and of their cost to the forwarding path while taken
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "driver_statistics.hpp"
+#include "ethernet_driver.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr uint32_t RECEIVER_ADDRESS = 0x01020304;
+    constexpr std::size_t FRAMES = 1 << 20;
+    constexpr std::size_t SNAPSHOTS = 20000;
+    constexpr std::size_t PAYLOAD_SIZE = 64;
+
+    // Takes every frame and does nothing with it
+    class NullReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t *, std::size_t) override {}
+            void receiveFrames(std::span<const FrameRef>) override {}
+    };
+
+    // CPU time of the calling thread, so a reader sharing the core does not count against the forwarding thread
+    double threadCpuNanoseconds() {
+        timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<double>(now.tv_sec) * 1e9 + static_cast<double>(now.tv_nsec);
+    }
+
+    /**
+     * @brief Store and forward FRAMES frames from flows sources, a queue full at a time
+     *
+     * @return double: CPU nanoseconds of this thread per frame
+     */
+    double forwardFrames(EthernetDriver& driver, std::size_t flows) {
+
+        // Initialize method variables
+        std::size_t frameSize = EthernetFrame::HEADER_SIZE + PAYLOAD_SIZE;
+        std::vector<uint8_t> frames(flows * frameSize, 0);
+
+        for (std::size_t i = 0; i < flows; ++i) {
+            EthernetFrame::writeHeader(frames.data() + i * frameSize, FrameHeaderSchema::addressToBytes(RECEIVER_ADDRESS),
+                                       FrameHeaderSchema::addressToBytes(static_cast<uint32_t>(0x0A000000 + i)), PAYLOAD_SIZE);
+        }
+
+        double start = threadCpuNanoseconds();
+        for (std::size_t sent = 0; sent < FRAMES; ) {
+            for (std::size_t i = 0; i < EthernetDriver::MAX_BUFFERED_FRAMES; ++i, ++sent) {
+                driver.storeSerializedFrame(frames.data() + (sent % flows) * frameSize, frameSize);
+            }
+            driver.processStoredFrame();
+        }
+        return (threadCpuNanoseconds() - start) / FRAMES;
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    const std::array<std::size_t, 3> flowCounts = {1, 16, FlowStatisticsTable::CAPACITY};
+    NullReceiver receiver;
+
+    std::printf("Driver statistics: %zu frames of %zu payload bytes per run\n", FRAMES, PAYLOAD_SIZE);
+
+    for (std::size_t flows : flowCounts) {
+        char variant[64];
+
+        // The forwarding path alone
+        double alone = 0.0;
+        {
+            EthernetDriver driver;
+            driver.registerReceiver(RECEIVER_ADDRESS, &receiver);
+            alone = forwardFrames(driver, flows);
+        }
+
+        // The same while another thread takes snapshots back to back
+        double observed = 0.0;
+        double snapshotNanoseconds = 0.0;
+        {
+            EthernetDriver driver;
+            std::atomic<bool> forwarding{true};
+            std::size_t snapshots = 0;
+
+            driver.registerReceiver(RECEIVER_ADDRESS, &receiver);
+            std::thread reader([&] {
+                DriverStatistics snapshot;
+                double start = threadCpuNanoseconds();
+                while (forwarding.load(std::memory_order_relaxed)) {
+                    driver.getStatistics(snapshot);
+                    snapshots++;
+                }
+                snapshotNanoseconds = (threadCpuNanoseconds() - start) / static_cast<double>(std::max<std::size_t>(snapshots, 1));
+                Bench::keep(snapshot);
+            });
+
+            observed = forwardFrames(driver, flows);
+            forwarding.store(false, std::memory_order_relaxed);
+            reader.join();
+        }
+
+        std::snprintf(variant, sizeof(variant), "%zu flows forward", flows);
+        Bench::report("driver_statistics", variant, alone, "ns/frame");
+        std::snprintf(variant, sizeof(variant), "%zu flows forward while read", flows);
+        Bench::report("driver_statistics", variant, observed, "ns/frame");
+        std::snprintf(variant, sizeof(variant), "%zu flows snapshot", flows);
+        Bench::report("driver_statistics", variant, snapshotNanoseconds, "ns/snapshot");
+    }
+
+    // Snapshot cost grows with the threads that have sent (one counter block each)
+    for (std::size_t senders : {1, 8, 64}) {
+        EthernetDriver driver;
+        DriverStatistics snapshot;
+        std::vector<uint8_t> frame(EthernetFrame::HEADER_SIZE + PAYLOAD_SIZE, 0);
+        char variant[64];
+
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> stored{0};
+        std::atomic<bool> measured{false};
+
+        // The senders stay alive until measured: a finished thread's id, and so its counters, may be reused
+        EthernetFrame::writeHeader(frame.data(), FrameHeaderSchema::addressToBytes(RECEIVER_ADDRESS), {0x0A, 0x0B, 0x0C, 0x0D}, PAYLOAD_SIZE);
+        driver.registerReceiver(RECEIVER_ADDRESS, &receiver);
+        for (std::size_t i = 0; i < senders; ++i) {
+            threads.emplace_back([&] {
+                while (ErrorCode::SUCCESS != driver.storeSerializedFrame(frame.data(), frame.size())) {
+                    std::this_thread::yield();
+                }
+                stored++;
+                while (!measured.load()) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        while (stored.load() < senders) {
+            driver.processStoredFrame();
+            std::this_thread::yield();
+        }
+
+        double snapshotCost = Bench::bestNanosecondsPer(SNAPSHOTS, [&] {
+            for (std::size_t i = 0; i < SNAPSHOTS; ++i) {
+                driver.getStatistics(snapshot);
+            }
+            Bench::keep(snapshot);
+        });
+
+        measured.store(true);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::snprintf(variant, sizeof(variant), "%zu sending threads snapshot", senders);
+        Bench::report("driver_statistics", variant, snapshotCost, "ns/snapshot");
+    }
+
+    return 0;
+}
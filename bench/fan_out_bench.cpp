@@ -0,0 +1,103 @@
+/**
+ * @file fan_out_bench.cpp
+ *
+ * @brief Benchmark of zero-copy group delivery against sending each member its own copy
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <cstdio>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "ethernet_driver.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr uint32_t GROUP_ADDRESS = 0xE0000001;
+    constexpr uint32_t SENDER_ADDRESS = 0x0A0B0C0D;
+    constexpr uint32_t FIRST_MEMBER = 0x01000000;
+    constexpr std::size_t DELIVERIES = 1 << 18;     // Frames handed to members per run
+
+    // Touches the first bytes of every frame, as a receiver parsing the header would
+    class HeaderReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t *data, std::size_t) override {
+                checksum += data[0];
+            }
+
+            void receiveFrames(std::span<const FrameRef> frames) override {
+                for (const FrameRef& frame : frames) {
+                    checksum += frame.data[0];
+                }
+            }
+
+            uint64_t checksum = 0;
+    };
+}
+
+int main() {
+
+    // Initialize method variables
+    const std::array<std::size_t, 4> memberCounts = {1, 4, 16, 64};
+    std::size_t frameSize = EthernetFrame::HEADER_SIZE + EthernetFrame::MAX_PAYLOAD_SIZE;
+
+    std::printf("Fan out of %zu byte frames to a group, %zu deliveries per run\n", frameSize, DELIVERIES);
+
+    for (std::size_t members : memberCounts) {
+        EthernetDriver driver;
+        std::vector<HeaderReceiver> receivers(members);
+        std::vector<uint8_t> groupFrame(frameSize, 0);
+        std::vector<std::vector<uint8_t>> memberFrames(members, std::vector<uint8_t>(frameSize, 0));
+        char variant[64];
+
+        for (std::size_t i = 0; i < members; ++i) {
+            uint32_t address = FIRST_MEMBER + static_cast<uint32_t>(i);
+            driver.registerReceiver(address, &receivers[i]);
+            driver.joinGroup(GROUP_ADDRESS, address);
+            EthernetFrame::writeHeader(memberFrames[i].data(), FrameHeaderSchema::addressToBytes(address),
+                                       FrameHeaderSchema::addressToBytes(SENDER_ADDRESS), EthernetFrame::MAX_PAYLOAD_SIZE);
+        }
+        EthernetFrame::writeHeader(groupFrame.data(), FrameHeaderSchema::addressToBytes(GROUP_ADDRESS),
+                                   FrameHeaderSchema::addressToBytes(SENDER_ADDRESS), EthernetFrame::MAX_PAYLOAD_SIZE);
+
+        // One stored frame handed to every member from its slot
+        double group = Bench::bestNanosecondsPer(DELIVERIES, [&] {
+            for (std::size_t delivered = 0; delivered < DELIVERIES; ) {
+                for (std::size_t i = 0; i < EthernetDriver::MAX_BUFFERED_FRAMES; ++i) {
+                    driver.storeSerializedFrame(groupFrame.data(), groupFrame.size());
+                }
+                driver.processStoredFrame();
+                delivered += EthernetDriver::MAX_BUFFERED_FRAMES * members;
+            }
+        });
+
+        // What a sender without groups does: store a copy per member
+        double unicast = Bench::bestNanosecondsPer(DELIVERIES, [&] {
+            std::size_t member = 0;
+            for (std::size_t delivered = 0; delivered < DELIVERIES; ) {
+                for (std::size_t i = 0; i < EthernetDriver::MAX_BUFFERED_FRAMES; ++i) {
+                    driver.storeSerializedFrame(memberFrames[member].data(), frameSize);
+                    member = (member + 1) % members;
+                }
+                driver.processStoredFrame();
+                delivered += EthernetDriver::MAX_BUFFERED_FRAMES;
+            }
+        });
+
+        std::snprintf(variant, sizeof(variant), "%zu members group", members);
+        Bench::report("fan_out", variant, group, "ns/delivery");
+        std::snprintf(variant, sizeof(variant), "%zu members copy per member", members);
+        Bench::report("fan_out", variant, unicast, "ns/delivery");
+        std::snprintf(variant, sizeof(variant), "%zu members speedup", members);
+        Bench::report("fan_out", variant, unicast / group, "x");
+        Bench::keep(receivers);
+    }
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file frame_classifier_bench.cpp
+ *
+ * @brief Microbenchmark of batch in place frame validation and classification against the per frame copy
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <cstdio>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "frame_classifier.hpp"
+#include "host.hpp"
+
+using namespace EthernetDriverSimulation;
+
+int main() {
+
+    // Initialize method variables
+    constexpr std::size_t ROUNDS = 200000;
+    const std::array<uint8_t, 4> destination = {0x00, 0x00, 0x00, 0x02};
+    const std::array<uint8_t, 4> source = {0x00, 0x00, 0x00, 0x01};
+    const std::array<std::size_t, 4> batchSizes = {1, Host::MAX_PACKETS, 16, 64};
+
+    // Frames packed back to back as in a receiver's rx buffer: video fragments with an acknowledgement every fourth frame
+    std::vector<uint8_t> buffer;
+    std::vector<FrameSegment> frames;
+    std::vector<std::size_t> offsets;
+    for (std::size_t i = 0; i < 64; ++i) {
+        std::size_t length = (i % 4 == 3) ? 3 : EthernetFrame::MAX_PAYLOAD_SIZE;
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + EthernetFrame::HEADER_SIZE + length, 0);
+        EthernetFrame::writeHeader(buffer.data() + offset, destination, source, static_cast<uint16_t>(length));
+        buffer[offset + EthernetFrame::HEADER_SIZE] = (length == 3) ? 0x20 : 0x00;
+        offsets.push_back(offset);
+    }
+    std::size_t framesEnd = buffer.size();
+    buffer.resize(framesEnd + EthernetFrame::MAX_FRAME_SIZE, 0);
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        std::size_t end = (i + 1 < offsets.size()) ? offsets[i + 1] : framesEnd;
+        frames.push_back({buffer.data() + offsets[i], end - offsets[i]});
+    }
+
+    std::vector<ErrorCode> statuses(frames.size());
+    std::vector<ExpectedPayloadData> types(frames.size());
+    EthernetFrame copy;
+
+    std::printf("Frame validation and classification (%zu byte max payload, Host::MAX_PACKETS = %zu)\n",
+                EthernetFrame::MAX_PAYLOAD_SIZE, Host::MAX_PACKETS);
+
+    for (std::size_t batch : batchSizes) {
+        std::span<const FrameSegment> input(frames.data(), batch);
+        std::span<ErrorCode> statusOut(statuses.data(), batch);
+        std::span<ExpectedPayloadData> typeOut(types.data(), batch);
+        char variant[64];
+
+        // What receivers did before: deserialize each frame into an EthernetFrame, then classify the copy
+        double perFrame = Bench::bestNanosecondsPer(ROUNDS * batch, [&] {
+            for (std::size_t round = 0; round < ROUNDS; ++round) {
+                for (std::size_t i = 0; i < batch; ++i) {
+                    statuses[i] = copy.fromHexSteam(input[i].data);
+                    types[i] = (ErrorCode::SUCCESS == statuses[i]) ? findFrameType(copy) : ExpectedPayloadData::UNKNOWN_PACKET;
+                }
+                Bench::keep(types);
+            }
+        });
+        double batched = Bench::bestNanosecondsPer(ROUNDS * batch, [&] {
+            for (std::size_t round = 0; round < ROUNDS; ++round) {
+                classifyFrames(input, statusOut, typeOut);
+                Bench::keep(types);
+            }
+        });
+
+        std::snprintf(variant, sizeof(variant), "batch %zu per frame copy", batch);
+        Bench::report("frame_classifier", variant, perFrame, "ns/frame");
+        std::snprintf(variant, sizeof(variant), "batch %zu in place", batch);
+        Bench::report("frame_classifier", variant, batched, "ns/frame");
+        std::snprintf(variant, sizeof(variant), "batch %zu speedup", batch);
+        Bench::report("frame_classifier", variant, perFrame / batched, "x");
+    }
+
+    return 0;
+}
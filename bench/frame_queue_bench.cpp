@@ -0,0 +1,118 @@
+/**
+ * @file frame_queue_bench.cpp
+ *
+ * @brief Contention benchmark of concurrent producers storing frames into one driver queue
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "ethernet_driver.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr uint32_t RECEIVER_ADDRESS = 0x01020304;
+    constexpr std::size_t FRAMES = 200000;          // Split between the producers of a run
+    constexpr std::size_t PAYLOAD_SIZE = 64;
+
+    // Counts what the driver forwards
+    class CountingReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t *, std::size_t) override {
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void receiveFrames(std::span<const FrameRef> frames) override {
+                received.fetch_add(frames.size(), std::memory_order_relaxed);
+            }
+
+            std::atomic<std::size_t> received{0};
+    };
+
+    // Per producer results, padded so producers never share a cache line
+    struct alignas(64) ProducerResult {
+        double enqueueNanoseconds = 0.0;    // Sum over the successful stores
+        std::size_t retries = 0;            // Stores refused because the queue was full
+    };
+}
+
+int main() {
+
+    // Initialize method variables
+    const std::array<std::size_t, 7> producerCounts = {1, 2, 4, 8, 16, 32, 64};
+    std::vector<uint8_t> frame(EthernetFrame::HEADER_SIZE + PAYLOAD_SIZE, 0);
+
+    EthernetFrame::writeHeader(frame.data(), {0x01, 0x02, 0x03, 0x04}, {0x0A, 0x0B, 0x0C, 0x0D}, PAYLOAD_SIZE);
+
+    std::printf("Concurrent storeSerializedFrame into one queue of %zu slots, %zu frames of %zu payload bytes per run, %u hardware threads\n",
+                EthernetDriver::MAX_BUFFERED_FRAMES, FRAMES, PAYLOAD_SIZE, std::thread::hardware_concurrency());
+
+    for (std::size_t producers : producerCounts) {
+        EthernetDriver driver;
+        CountingReceiver receiver;
+        std::vector<ProducerResult> results(producers);
+        std::vector<std::thread> threads;
+        std::size_t perProducer = FRAMES / producers;
+        std::size_t total = perProducer * producers;
+        char variant[64];
+
+        driver.registerReceiver(RECEIVER_ADDRESS, &receiver);
+
+        Bench::Clock::time_point start = Bench::Clock::now();
+        for (std::size_t producer = 0; producer < producers; ++producer) {
+            threads.emplace_back([&, producer] {
+                ProducerResult& result = results[producer];
+                for (std::size_t i = 0; i < perProducer; ) {
+                    Bench::Clock::time_point before = Bench::Clock::now();
+                    ErrorCode status = driver.storeSerializedFrame(frame.data(), frame.size());
+                    if (ErrorCode::SUCCESS == status) {
+                        std::chrono::duration<double, std::nano> elapsed = Bench::Clock::now() - before;
+                        result.enqueueNanoseconds += elapsed.count();
+                        i++;
+                    }
+                    else {
+                        result.retries++;
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // This thread is the single consumer
+        while (receiver.received.load(std::memory_order_relaxed) < total) {
+            driver.processStoredFrame();
+            std::this_thread::yield();
+        }
+        std::chrono::duration<double> elapsed = Bench::Clock::now() - start;
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        double enqueueNanoseconds = 0.0;
+        std::size_t retries = 0;
+        for (const ProducerResult& result : results) {
+            enqueueNanoseconds += result.enqueueNanoseconds;
+            retries += result.retries;
+        }
+
+        std::snprintf(variant, sizeof(variant), "%zu producers enqueue latency", producers);
+        Bench::report("frame_queue", variant, enqueueNanoseconds / total, "ns/frame");
+        std::snprintf(variant, sizeof(variant), "%zu producers full queue retries", producers);
+        Bench::report("frame_queue", variant, static_cast<double>(retries) / total, "/frame");
+        std::snprintf(variant, sizeof(variant), "%zu producers throughput", producers);
+        Bench::report("frame_queue", variant, total / elapsed.count() / 1e6, "Mframes/s");
+    }
+
+    return 0;
+}
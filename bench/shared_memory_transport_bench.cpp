@@ -0,0 +1,338 @@
+/**
+ * @file shared_memory_transport_bench.cpp
+ *
+ * @brief Benchmark of frame streaming and round trips between two processes over shared memory against the in-process path
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "ethernet_driver.hpp"
+#include "frame_header_schema.hpp"
+#include "frame_view.hpp"
+#include "shared_memory_transport.hpp"
+
+#if defined(__linux__)
+
+// Linux Includes
+#include <sys/wait.h>
+#include <unistd.h>
+
+#endif // __linux__
+
+using namespace EthernetDriverSimulation;
+
+#if defined(__linux__)
+
+namespace {
+    constexpr uint32_t CREATOR_ADDRESS = 0x0A000001;
+    constexpr uint32_t ATTACHER_ADDRESS = 0x0B000002;
+    constexpr std::size_t PAYLOAD_SIZE = 1000;
+    constexpr std::size_t STREAM_FRAMES = 200000;
+    constexpr std::size_t ROUND_TRIPS = 2000;
+    constexpr uint64_t HELLO = 0;                               // Sequence numbers of the control frames
+    constexpr uint64_t END_OF_STREAM = ~uint64_t{0};
+    constexpr std::chrono::milliseconds IDLE_WAIT{5};
+    const char* const REGION_NAME = "eds-transport-bench";
+
+    // Sorts frames by the sequence number carried in their first payload bytes: stream frames, round trips and control frames
+    class SequenceReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t* data, std::size_t) override {
+
+                // Initialize method variables
+                uint64_t sequence = 0;
+
+                std::memcpy(&sequence, FrameView(data).payload().data(), sizeof(sequence));
+                if (sequence == HELLO) {
+                    hellos.fetch_add(1, std::memory_order_release);
+                }
+                else if (sequence == END_OF_STREAM) {
+                    ends.fetch_add(1, std::memory_order_release);
+                }
+                else if (sequence <= STREAM_FRAMES) {
+                    streamFrames.fetch_add(1, std::memory_order_release);
+                }
+                else {
+                    lastTrip.store(sequence - STREAM_FRAMES, std::memory_order_release);
+                }
+            }
+
+            std::atomic<std::size_t> hellos{0};
+            std::atomic<std::size_t> ends{0};
+            std::atomic<std::size_t> streamFrames{0};
+            std::atomic<uint64_t> lastTrip{0};      // Round trips are numbered after the stream's sequence numbers
+    };
+
+    /**
+     * @brief One process's end of the link: its own driver, a receiver and the transport to the peer, serviced on one thread
+     */
+    class Side {
+        public:
+            Side(bool creator)
+                : creator(creator),
+                  transport(&driver),
+                  localAddress(creator ? CREATOR_ADDRESS : ATTACHER_ADDRESS),
+                  peerAddress(creator ? ATTACHER_ADDRESS : CREATOR_ADDRESS),
+                  payload(PAYLOAD_SIZE, 0)
+            {
+                driver.registerReceiver(localAddress, &receiver);
+            }
+
+            ErrorCode open() {
+
+                // Initialize method variables
+                SharedMemoryTransport::Role role = creator ? SharedMemoryTransport::Role::CREATE : SharedMemoryTransport::Role::ATTACH;
+                ErrorCode status = ErrorCode::SUCCESS;
+
+                while (ErrorCode::TRANSPORT_NOT_READY == (status = transport.open(REGION_NAME, role, peerAddress))) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                if (ErrorCode::SUCCESS != status) {
+                    return status;
+                }
+
+                // The attacher says hello first, so both know the other end is up before anything is timed
+                if (!creator) {
+                    sendBlocking(HELLO);
+                }
+                serviceUntil([this] { return receiver.hellos.load(std::memory_order_acquire) != 0; });
+                if (creator) {
+                    sendBlocking(HELLO);
+                }
+                return ErrorCode::SUCCESS;
+            }
+
+            // Store one frame for the peer; false while the peer's ring has no room
+            bool send(uint64_t sequence) {
+
+                // Initialize method variables
+                FramePayload frame = {FrameHeaderSchema::addressToBytes(peerAddress), FrameHeaderSchema::addressToBytes(localAddress),
+                                      payload.data(), static_cast<uint16_t>(PAYLOAD_SIZE), false};
+                std::size_t framesStored = 0;
+
+                std::memcpy(payload.data(), &sequence, sizeof(sequence));
+                return ErrorCode::SUCCESS == driver.storeSerializedFrames(std::span<const FramePayload>(&frame, 1), framesStored) &&
+                       framesStored == 1;
+            }
+
+            void sendBlocking(uint64_t sequence) {
+                while (!send(sequence)) {
+                    serviceOrWait();
+                }
+                while (driver.hasStoredFrames()) {
+                    serviceOrWait();
+                }
+            }
+
+            template <typename Done>
+            void serviceUntil(Done done) {
+                while (!done()) {
+                    serviceOrWait();
+                }
+            }
+
+            // Move frames both ways; sleep on the transport only when there was nothing to do
+            void serviceOrWait() {
+
+                // Initialize method variables
+                std::size_t work = transport.poll(SharedMemoryTransport::RING_FRAMES);
+
+                for (std::size_t i = 0; i < SharedMemoryTransport::RING_FRAMES && driver.hasStoredFrames(); ++i) {
+                    driver.processStoredFrame();
+                    work++;
+                }
+                if (work == 0) {
+                    transport.wait(IDLE_WAIT);
+                }
+            }
+
+            bool creator;
+            EthernetDriver driver;
+            SequenceReceiver receiver;
+            SharedMemoryTransport transport;
+            uint32_t localAddress;
+            uint32_t peerAddress;
+            std::vector<uint8_t> payload;
+    };
+
+    double percentile(std::vector<double>& samples, std::size_t percent) {
+        std::sort(samples.begin(), samples.end());
+        return samples[std::min(samples.size() - 1, samples.size() * percent / 100)];
+    }
+
+    /**
+     * @brief Stream frames to the attacher, then play ping-pong with it; the attacher reports its receive side syscalls
+     */
+    int runSide(bool creator) {
+
+        // Initialize method variables
+        Side side(creator);
+        std::vector<double> roundTrips;
+        ErrorCode status = side.open();
+
+        if (ErrorCode::SUCCESS != status) {
+            std::printf("shared_memory_transport: open failed: %s\n", errorCodeToString(status).data());
+            return 1;
+        }
+
+        // Stream: the creator sends as fast as the ring takes frames and ends it; the attacher acknowledges the end
+        TransportStatistics before = side.transport.getStatistics();
+        Bench::Clock::time_point start = Bench::Clock::now();
+        if (creator) {
+            for (uint64_t sequence = 1; sequence <= STREAM_FRAMES; ++sequence) {
+                while (!side.send(sequence)) {
+                    side.serviceOrWait();
+                }
+            }
+            side.sendBlocking(END_OF_STREAM);
+            side.serviceUntil([&side] { return side.receiver.ends.load(std::memory_order_acquire) != 0; });
+            std::chrono::duration<double> elapsed = Bench::Clock::now() - start;
+            TransportStatistics after = side.transport.getStatistics();
+
+            Bench::report("shared_memory_transport", "stream, processes", STREAM_FRAMES / elapsed.count() / 1e6, "Mframes/s");
+            Bench::report("shared_memory_transport", "stream, processes", STREAM_FRAMES * PAYLOAD_SIZE * 8 / elapsed.count() / 1e9, "Gbit/s");
+            Bench::report("shared_memory_transport", "stream, sender syscalls",
+                          static_cast<double>(after.systemCalls - before.systemCalls) / STREAM_FRAMES, "/frame");
+        }
+        else {
+            side.serviceUntil([&side] { return side.receiver.ends.load(std::memory_order_acquire) != 0; });
+            TransportStatistics after = side.transport.getStatistics();
+
+            // The rings keep frames in order, so the whole stream is in before its end
+            if (side.receiver.streamFrames.load() != STREAM_FRAMES) {
+                std::printf("shared_memory_transport: received %zu of %zu stream frames\n", side.receiver.streamFrames.load(), STREAM_FRAMES);
+            }
+            Bench::report("shared_memory_transport", "stream, receiver syscalls",
+                          static_cast<double>(after.systemCalls - before.systemCalls) / STREAM_FRAMES, "/frame");
+            std::fflush(stdout);
+            side.sendBlocking(END_OF_STREAM);
+        }
+
+        // Ping-pong: one frame each way at a time, timed on the creator
+        before = side.transport.getStatistics();
+        for (uint64_t trip = 1; trip <= ROUND_TRIPS; ++trip) {
+            Bench::Clock::time_point sent = Bench::Clock::now();
+            if (creator) {
+                side.sendBlocking(STREAM_FRAMES + trip);
+                side.serviceUntil([&side, trip] { return side.receiver.lastTrip.load(std::memory_order_acquire) >= trip; });
+                roundTrips.push_back(std::chrono::duration<double, std::micro>(Bench::Clock::now() - sent).count());
+            }
+            else {
+                side.serviceUntil([&side, trip] { return side.receiver.lastTrip.load(std::memory_order_acquire) >= trip; });
+                side.sendBlocking(STREAM_FRAMES + trip);
+            }
+        }
+
+        if (creator) {
+            TransportStatistics after = side.transport.getStatistics();
+            Bench::report("shared_memory_transport", "round trip, processes p50", percentile(roundTrips, 50), "us");
+            Bench::report("shared_memory_transport", "round trip, processes p99", percentile(roundTrips, 99), "us");
+            Bench::report("shared_memory_transport", "round trip, creator syscalls",
+                          static_cast<double>(after.systemCalls - before.systemCalls) / ROUND_TRIPS, "/trip");
+        }
+
+        side.transport.close();
+        return 0;
+    }
+
+    /**
+     * @brief The same two exchanges between two threads sharing one driver with workers, the in-process path
+     */
+    void runInProcess() {
+
+        // Initialize method variables
+        EthernetDriver driver;
+        SequenceReceiver creator;
+        SequenceReceiver attacher;
+        std::vector<double> roundTrips;
+
+        auto send = [&driver](uint32_t destination, uint32_t source, uint64_t sequence) {
+            std::array<uint8_t, PAYLOAD_SIZE> payload = {};
+            std::memcpy(payload.data(), &sequence, sizeof(sequence));
+            FramePayload frame = {FrameHeaderSchema::addressToBytes(destination), FrameHeaderSchema::addressToBytes(source),
+                                  payload.data(), static_cast<uint16_t>(PAYLOAD_SIZE), false};
+            driver.storeSerializedFramesBlocking(std::span<const FramePayload>(&frame, 1));
+        };
+
+        driver.registerReceiver(CREATOR_ADDRESS, &creator);
+        driver.registerReceiver(ATTACHER_ADDRESS, &attacher);
+        driver.startWorkers();
+
+        Bench::Clock::time_point start = Bench::Clock::now();
+        for (uint64_t sequence = 1; sequence <= STREAM_FRAMES; ++sequence) {
+            send(ATTACHER_ADDRESS, CREATOR_ADDRESS, sequence);
+        }
+        while (attacher.streamFrames.load(std::memory_order_acquire) < STREAM_FRAMES) {
+            std::this_thread::yield();
+        }
+        std::chrono::duration<double> elapsed = Bench::Clock::now() - start;
+
+        std::thread echo([&] {
+            for (uint64_t trip = 1; trip <= ROUND_TRIPS; ++trip) {
+                while (attacher.lastTrip.load(std::memory_order_acquire) < trip) {
+                    std::this_thread::yield();
+                }
+                send(CREATOR_ADDRESS, ATTACHER_ADDRESS, STREAM_FRAMES + trip);
+            }
+        });
+        for (uint64_t trip = 1; trip <= ROUND_TRIPS; ++trip) {
+            Bench::Clock::time_point sent = Bench::Clock::now();
+            send(ATTACHER_ADDRESS, CREATOR_ADDRESS, STREAM_FRAMES + trip);
+            while (creator.lastTrip.load(std::memory_order_acquire) < trip) {
+                std::this_thread::yield();
+            }
+            roundTrips.push_back(std::chrono::duration<double, std::micro>(Bench::Clock::now() - sent).count());
+        }
+        echo.join();
+        driver.stopWorkers();
+
+        Bench::report("shared_memory_transport", "stream, in process", STREAM_FRAMES / elapsed.count() / 1e6, "Mframes/s");
+        Bench::report("shared_memory_transport", "stream, in process", STREAM_FRAMES * PAYLOAD_SIZE * 8 / elapsed.count() / 1e9, "Gbit/s");
+        Bench::report("shared_memory_transport", "round trip, in process p50", percentile(roundTrips, 50), "us");
+        Bench::report("shared_memory_transport", "round trip, in process p99", percentile(roundTrips, 99), "us");
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    pid_t attacher = 0;
+    int attacherStatus = 0;
+    int status = 0;
+
+    std::printf("%zu frames streamed and %zu round trips of %zu byte payloads, %zu frame rings, %u CPUs\n",
+                STREAM_FRAMES, ROUND_TRIPS, PAYLOAD_SIZE, SharedMemoryTransport::RING_FRAMES, std::thread::hardware_concurrency());
+    std::fflush(stdout);
+
+    attacher = fork();
+    if (attacher == 0) {
+        _exit(runSide(false));
+    }
+    status = runSide(true);
+    waitpid(attacher, &attacherStatus, 0);
+    status |= WIFEXITED(attacherStatus) ? WEXITSTATUS(attacherStatus) : 1;
+
+    runInProcess();
+    return status;
+}
+
+#else
+
+int main() {
+    std::printf("shared_memory_transport: Linux only, skipped\n");
+    return 0;
+}
+
+#endif // __linux__
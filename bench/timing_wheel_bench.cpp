@@ -0,0 +1,173 @@
+/**
+ * @file timing_wheel_bench.cpp
+ *
+ * @brief Benchmark of timer schedule, reschedule, cancel and expiry on the timing wheel against an ordered map
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <array>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "timing_wheel.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr uint64_t RESOLUTION = 1000;                       // The driver's TIMER_RESOLUTION: 1 us ticks
+    constexpr uint64_t HORIZON = 10000000000;                   // Expiries spread over 10 s
+    constexpr uint64_t STEP = 1000000;                          // Expired 1 ms at a time, as a service loop would
+
+    struct Costs {
+        double schedule;
+        double reschedule;
+        double cancel;
+        double expire;
+    };
+
+    /**
+     * @brief Schedule every timer, move each once, cancel every other one and expire the rest over the horizon
+     *
+     * @return Costs: nanoseconds per timer of each phase, the best of five runs
+     */
+    Costs measureWheel(const std::vector<uint64_t>& expiries, const std::vector<uint64_t>& moves) {
+
+        // Initialize method variables
+        std::size_t timerCount = expiries.size();
+        Costs best = {1e30, 1e30, 1e30, 1e30};
+
+        for (int run = 0; run < 5; ++run) {
+            TimingWheel wheel(RESOLUTION, 0);
+            std::vector<TimingWheel::TimerId> ids(timerCount);
+            TimingWheel::Callback callback;
+            std::size_t fired = 0;
+
+            Bench::Clock::time_point start = Bench::Clock::now();
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                ids[i] = wheel.schedule(expiries[i], [&fired] { fired++; });
+            }
+            Bench::Clock::time_point scheduled = Bench::Clock::now();
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                wheel.reschedule(ids[i], moves[i]);
+            }
+            Bench::Clock::time_point rescheduled = Bench::Clock::now();
+            for (std::size_t i = 0; i < timerCount; i += 2) {
+                wheel.cancel(ids[i]);
+            }
+            Bench::Clock::time_point cancelled = Bench::Clock::now();
+            for (uint64_t now = 0; now <= HORIZON; now += STEP) {
+                while (wheel.expire(now, callback)) {
+                    callback();
+                }
+            }
+            Bench::Clock::time_point expired = Bench::Clock::now();
+            Bench::keep(fired);
+
+            std::chrono::duration<double, std::nano> phases[4] = {scheduled - start, rescheduled - scheduled,
+                                                                 cancelled - rescheduled, expired - cancelled};
+            best.schedule = std::min(best.schedule, phases[0].count() / timerCount);
+            best.reschedule = std::min(best.reschedule, phases[1].count() / timerCount);
+            best.cancel = std::min(best.cancel, phases[2].count() / (timerCount / 2));
+            best.expire = std::min(best.expire, phases[3].count() / (timerCount - timerCount / 2));
+        }
+        return best;
+    }
+
+    /**
+     * @brief The same phases on an ordered multimap, the usual timer queue that can also cancel
+     */
+    Costs measureOrderedMap(const std::vector<uint64_t>& expiries, const std::vector<uint64_t>& moves) {
+
+        // Initialize method variables
+        using TimerMap = std::multimap<uint64_t, TimingWheel::Callback>;
+        std::size_t timerCount = expiries.size();
+        Costs best = {1e30, 1e30, 1e30, 1e30};
+
+        for (int run = 0; run < 5; ++run) {
+            TimerMap timers;
+            std::vector<TimerMap::iterator> ids(timerCount);
+            std::size_t fired = 0;
+
+            Bench::Clock::time_point start = Bench::Clock::now();
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                ids[i] = timers.emplace(expiries[i], [&fired] { fired++; });
+            }
+            Bench::Clock::time_point scheduled = Bench::Clock::now();
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                TimerMap::node_type node = timers.extract(ids[i]);
+                node.key() = moves[i];
+                ids[i] = timers.insert(std::move(node));
+            }
+            Bench::Clock::time_point rescheduled = Bench::Clock::now();
+            for (std::size_t i = 0; i < timerCount; i += 2) {
+                timers.erase(ids[i]);
+            }
+            Bench::Clock::time_point cancelled = Bench::Clock::now();
+            for (uint64_t now = 0; now <= HORIZON; now += STEP) {
+                while (!timers.empty() && timers.begin()->first <= now) {
+                    TimingWheel::Callback callback = std::move(timers.begin()->second);
+                    timers.erase(timers.begin());
+                    callback();
+                }
+            }
+            Bench::Clock::time_point expired = Bench::Clock::now();
+            Bench::keep(fired);
+
+            std::chrono::duration<double, std::nano> phases[4] = {scheduled - start, rescheduled - scheduled,
+                                                                 cancelled - rescheduled, expired - cancelled};
+            best.schedule = std::min(best.schedule, phases[0].count() / timerCount);
+            best.reschedule = std::min(best.reschedule, phases[1].count() / timerCount);
+            best.cancel = std::min(best.cancel, phases[2].count() / (timerCount / 2));
+            best.expire = std::min(best.expire, phases[3].count() / (timerCount - timerCount / 2));
+        }
+        return best;
+    }
+
+    void reportCosts(const char* structure, std::size_t timerCount, const Costs& costs) {
+
+        // Initialize method variables
+        const std::array<std::pair<const char*, double>, 4> phases = {{
+            {"schedule", costs.schedule}, {"reschedule", costs.reschedule},
+            {"cancel", costs.cancel}, {"expire", costs.expire}
+        }};
+        char variant[64];
+
+        for (const auto& phase : phases) {
+            std::snprintf(variant, sizeof(variant), "%s %zu timers %s", structure, timerCount, phase.first);
+            Bench::report("timing_wheel", variant, phase.second, "ns/timer");
+        }
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    const std::array<std::size_t, 3> timerCounts = {1000, 100000, 500000};
+    std::mt19937_64 random(1);
+
+    std::printf("Timers over a %llu s horizon at %llu ns resolution, expired every %llu ms\n",
+                static_cast<unsigned long long>(HORIZON / 1000000000), static_cast<unsigned long long>(RESOLUTION),
+                static_cast<unsigned long long>(STEP / 1000000));
+
+    for (std::size_t timerCount : timerCounts) {
+        std::vector<uint64_t> expiries(timerCount);
+        std::vector<uint64_t> moves(timerCount);
+
+        for (std::size_t i = 0; i < timerCount; ++i) {
+            expiries[i] = random() % HORIZON;
+            moves[i] = random() % HORIZON;
+        }
+
+        reportCosts("wheel", timerCount, measureWheel(expiries, moves));
+        reportCosts("multimap", timerCount, measureOrderedMap(expiries, moves));
+    }
+
+    return 0;
+}
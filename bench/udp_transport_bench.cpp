@@ -0,0 +1,291 @@
+/**
+ * @file udp_transport_bench.cpp
+ *
+ * @brief Benchmark of frame streaming and round trips between two processes over the batched loopback UDP transport
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "ethernet_driver.hpp"
+#include "frame_header_schema.hpp"
+#include "frame_view.hpp"
+#include "udp_transport.hpp"
+
+#if defined(__linux__)
+
+// Linux Includes
+#include <sys/wait.h>
+#include <unistd.h>
+
+#endif // __linux__
+
+using namespace EthernetDriverSimulation;
+
+#if defined(__linux__)
+
+namespace {
+    constexpr uint32_t FIRST_ADDRESS = 0x0A000001;
+    constexpr uint32_t SECOND_ADDRESS = 0x0B000002;
+    constexpr uint16_t FIRST_PORT = 40101;
+    constexpr uint16_t SECOND_PORT = 40102;
+    constexpr std::size_t PAYLOAD_SIZE = 1000;
+    constexpr std::size_t STREAM_FRAMES = 200000;
+    constexpr std::size_t ROUND_TRIPS = 2000;
+    constexpr uint64_t HELLO = 0;                               // Sequence numbers of the control frames
+    constexpr uint64_t END_OF_STREAM = ~uint64_t{0};
+    constexpr std::chrono::milliseconds IDLE_WAIT{5};
+    constexpr std::chrono::milliseconds RESEND_AFTER{20};       // UDP may lose the hello or the end of the stream
+
+    // Sorts frames by the sequence number carried in their first payload bytes: stream frames, round trips and control frames
+    class SequenceReceiver : public PacketReceiver {
+        public:
+            void receiveFrame(const uint8_t* data, std::size_t) override {
+
+                // Initialize method variables
+                uint64_t sequence = 0;
+
+                std::memcpy(&sequence, FrameView(data).payload().data(), sizeof(sequence));
+                if (sequence == HELLO) {
+                    hellos++;
+                }
+                else if (sequence == END_OF_STREAM) {
+                    ends++;
+                }
+                else if (sequence <= STREAM_FRAMES) {
+                    streamFrames++;
+                }
+                else {
+                    lastTrip = std::max(lastTrip, sequence - STREAM_FRAMES);
+                }
+            }
+
+            std::size_t hellos = 0;
+            std::size_t ends = 0;
+            std::size_t streamFrames = 0;
+            uint64_t lastTrip = 0;                  // Round trips are numbered after the stream's sequence numbers
+    };
+
+    /**
+     * @brief One process's end of the link: its own driver, a receiver and the transport to the peer, serviced on one thread
+     */
+    class Side {
+        public:
+            Side(bool first)
+                : first(first),
+                  transport(&driver),
+                  localAddress(first ? FIRST_ADDRESS : SECOND_ADDRESS),
+                  peerAddress(first ? SECOND_ADDRESS : FIRST_ADDRESS),
+                  payload(PAYLOAD_SIZE, 0)
+            {
+                driver.registerReceiver(localAddress, &receiver);
+            }
+
+            ErrorCode open() {
+
+                // Initialize method variables
+                ErrorCode status = first ? transport.open(FIRST_PORT, SECOND_PORT, peerAddress)
+                                         : transport.open(SECOND_PORT, FIRST_PORT, peerAddress);
+
+                if (ErrorCode::SUCCESS != status) {
+                    return status;
+                }
+
+                // The second side says hello until the first answers, so both know the other end is bound
+                if (first) {
+                    serviceUntil([this] { return receiver.hellos != 0; });
+                    sendBlocking(HELLO);
+                }
+                else {
+                    sendUntilAnswered(HELLO, receiver.hellos);
+                }
+                return ErrorCode::SUCCESS;
+            }
+
+            // Store one frame for the peer; false while the transport holds a full batch
+            bool send(uint64_t sequence) {
+
+                // Initialize method variables
+                FramePayload frame = {FrameHeaderSchema::addressToBytes(peerAddress), FrameHeaderSchema::addressToBytes(localAddress),
+                                      payload.data(), static_cast<uint16_t>(PAYLOAD_SIZE), false};
+                std::size_t framesStored = 0;
+
+                std::memcpy(payload.data(), &sequence, sizeof(sequence));
+                return ErrorCode::SUCCESS == driver.storeSerializedFrames(std::span<const FramePayload>(&frame, 1), framesStored) &&
+                       framesStored == 1;
+            }
+
+            // Store a frame and service the link until it left in a datagram
+            void sendBlocking(uint64_t sequence) {
+                while (!send(sequence)) {
+                    serviceOrWait();
+                }
+                while (driver.hasStoredFrames()) {
+                    serviceOrWait();
+                }
+                transport.flush();
+            }
+
+            void sendUntilAnswered(uint64_t sequence, const std::size_t& answers) {
+
+                // Initialize method variables
+                std::size_t before = answers;
+
+                while (answers == before) {
+                    sendBlocking(sequence);
+                    Bench::Clock::time_point sent = Bench::Clock::now();
+                    while (answers == before && Bench::Clock::now() - sent < RESEND_AFTER) {
+                        serviceOrWait();
+                    }
+                }
+            }
+
+            template <typename Done>
+            void serviceUntil(Done done) {
+                while (!done()) {
+                    serviceOrWait();
+                }
+            }
+
+            // Move frames both ways; sleep on the socket only when there was nothing to do
+            void serviceOrWait() {
+
+                // Initialize method variables
+                std::size_t work = transport.poll(UdpTransport::BATCH_FRAMES);
+
+                for (std::size_t i = 0; i < UdpTransport::BATCH_FRAMES && driver.hasStoredFrames(); ++i) {
+                    driver.processStoredFrame();
+                    work++;
+                }
+                if (work == 0) {
+                    transport.wait(IDLE_WAIT);
+                }
+            }
+
+            bool first;
+            EthernetDriver driver;
+            SequenceReceiver receiver;
+            UdpTransport transport;
+            uint32_t localAddress;
+            uint32_t peerAddress;
+            std::vector<uint8_t> payload;
+    };
+
+    double percentile(std::vector<double>& samples, std::size_t percent) {
+        std::sort(samples.begin(), samples.end());
+        return samples[std::min(samples.size() - 1, samples.size() * percent / 100)];
+    }
+
+    /**
+     * @brief Stream frames to the second side, then play ping-pong with it; the second side reports its receive side syscalls
+     */
+    int runSide(bool first) {
+
+        // Initialize method variables
+        Side side(first);
+        std::vector<double> roundTrips;
+        ErrorCode status = side.open();
+
+        if (ErrorCode::SUCCESS != status) {
+            std::printf("udp_transport: open failed: %s\n", errorCodeToString(status).data());
+            return 1;
+        }
+
+        // Stream: the first side sends as fast as the transport takes frames, then the end until it is acknowledged
+        TransportStatistics before = side.transport.getStatistics();
+        Bench::Clock::time_point start = Bench::Clock::now();
+        if (first) {
+            for (uint64_t sequence = 1; sequence <= STREAM_FRAMES; ++sequence) {
+                while (!side.send(sequence)) {
+                    side.serviceOrWait();
+                }
+            }
+            side.sendUntilAnswered(END_OF_STREAM, side.receiver.ends);
+            std::chrono::duration<double> elapsed = Bench::Clock::now() - start;
+            TransportStatistics after = side.transport.getStatistics();
+
+            Bench::report("udp_transport", "stream", STREAM_FRAMES / elapsed.count() / 1e6, "Mframes/s");
+            Bench::report("udp_transport", "stream", STREAM_FRAMES * PAYLOAD_SIZE * 8 / elapsed.count() / 1e9, "Gbit/s");
+            Bench::report("udp_transport", "stream, sender syscalls",
+                          static_cast<double>(after.systemCalls - before.systemCalls) / STREAM_FRAMES, "/frame");
+        }
+        else {
+            side.serviceUntil([&side] { return side.receiver.ends != 0; });
+            TransportStatistics after = side.transport.getStatistics();
+            std::size_t streamed = side.receiver.streamFrames;
+
+            Bench::report("udp_transport", "stream, receiver syscalls",
+                          static_cast<double>(after.systemCalls - before.systemCalls) / streamed, "/frame");
+            Bench::report("udp_transport", "stream, frames lost",
+                          100.0 * static_cast<double>(STREAM_FRAMES - streamed) / STREAM_FRAMES, "%");
+            std::fflush(stdout);
+            side.sendBlocking(END_OF_STREAM);
+        }
+
+        // Ping-pong: one frame each way at a time, timed on the first side
+        before = side.transport.getStatistics();
+        for (uint64_t trip = 1; trip <= ROUND_TRIPS; ++trip) {
+            Bench::Clock::time_point sent = Bench::Clock::now();
+            if (first) {
+                side.sendBlocking(STREAM_FRAMES + trip);
+                side.serviceUntil([&side, trip] { return side.receiver.lastTrip >= trip; });
+                roundTrips.push_back(std::chrono::duration<double, std::micro>(Bench::Clock::now() - sent).count());
+            }
+            else {
+                side.serviceUntil([&side, trip] { return side.receiver.lastTrip >= trip; });
+                side.sendBlocking(STREAM_FRAMES + trip);
+            }
+        }
+
+        if (first) {
+            TransportStatistics after = side.transport.getStatistics();
+            Bench::report("udp_transport", "round trip p50", percentile(roundTrips, 50), "us");
+            Bench::report("udp_transport", "round trip p99", percentile(roundTrips, 99), "us");
+            Bench::report("udp_transport", "round trip, first side syscalls",
+                          static_cast<double>(after.systemCalls - before.systemCalls) / ROUND_TRIPS, "/trip");
+        }
+
+        side.transport.close();
+        return 0;
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    pid_t second = 0;
+    int secondStatus = 0;
+    int status = 0;
+
+    std::printf("%zu frames streamed and %zu round trips of %zu byte payloads over loopback UDP, %zu frame batches\n",
+                STREAM_FRAMES, ROUND_TRIPS, PAYLOAD_SIZE, UdpTransport::BATCH_FRAMES);
+    std::fflush(stdout);
+
+    second = fork();
+    if (second == 0) {
+        _exit(runSide(false));
+    }
+    status = runSide(true);
+    waitpid(second, &secondStatus, 0);
+    status |= WIFEXITED(secondStatus) ? WEXITSTATUS(secondStatus) : 1;
+
+    return status;
+}
+
+#else
+
+int main() {
+    std::printf("udp_transport: Linux only, skipped\n");
+    return 0;
+}
+
+#endif // __linux__
@@ -0,0 +1,217 @@
+/**
+ * @file video_transfer_bench.cpp
+ *
+ * @brief Benchmark of a fragmented video transfer from the device to a receiver at the built frame size
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Project Includes
+#include "bench_support.hpp"
+#include "embedded_device.hpp"
+#include "ethernet_driver.hpp"
+#include "fragment_header.hpp"
+#include "frame_classifier.hpp"
+#include "frame_view.hpp"
+#include "stream_reassembler.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr uint32_t RECEIVER_ADDRESS = 0x01020304;
+    constexpr uint32_t DEVICE_ADDRESS = 0x0A0B0C0D;
+    constexpr std::size_t STREAM_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * @brief Receiving end of the transfer, built like Host: an rx buffer of
+     * BUFFER_SIZE bytes with one credit per frame it holds, classified in one
+     * batch and reassembled into memory instead of a file
+     */
+    class StreamReceiver : public PacketReceiver {
+        public:
+            static constexpr std::size_t MAX_PACKETS = EthernetFrame::BUFFER_SIZE / EthernetFrame::MAX_FRAME_SIZE;
+
+            StreamReceiver(EthernetDriver* driver, uint32_t address)
+                : driver(driver),
+                  address(address),
+                  reassembler([this](std::span<const uint8_t> data) { stream.insert(stream.end(), data.begin(), data.end()); })
+            {
+                rxSlab = std::make_unique_for_overwrite<uint8_t[]>(EthernetFrame::BUFFER_SIZE);
+                driver->registerReceiver(address, this, MAX_PACKETS);
+            }
+
+            void receiveFrame(const uint8_t *data, std::size_t size) override {
+                FrameRef frame = {data, size};
+                receiveFrames(std::span<const FrameRef>(&frame, 1));
+            }
+
+            void receiveFrames(std::span<const FrameRef> frames) override {
+                for (const FrameRef& frame : frames) {
+                    std::memcpy(rxSlab.get() + rxSlabUsed, frame.data, frame.size);
+                    rxFrames[rxCount++] = {rxSlab.get() + rxSlabUsed, frame.size};
+                    rxSlabUsed += frame.size;
+                }
+            }
+
+            void processReceivedFrames() {
+                classifyFrames(std::span<const FrameSegment>(rxFrames.data(), rxCount),
+                               std::span<ErrorCode>(statuses.data(), rxCount),
+                               std::span<ExpectedPayloadData>(types.data(), rxCount));
+
+                for (std::size_t i = 0; i < rxCount; ++i) {
+                    FragmentHeader fragment;
+                    std::span<const uint8_t> payload = FrameView(rxFrames[i].data).payload();
+
+                    if (ErrorCode::SUCCESS == statuses[i] && ExpectedPayloadData::VIDEO_DATA == types[i] &&
+                        ErrorCode::SUCCESS == fragment.parse(payload)) {
+                        reassembler.acceptFragment(fragment, payload.subspan(FragmentHeader::SIZE));
+                    }
+                }
+
+                driver->grantCredit(address, rxCount);
+                rxCount = 0;
+                rxSlabUsed = 0;
+            }
+
+            bool isComplete() const { return reassembler.isComplete(); }
+            std::size_t streamSize() const { return stream.size(); }
+
+            void reset() {
+                reassembler.reset();
+                stream.clear();
+            }
+
+        private:
+            EthernetDriver* driver;
+            uint32_t address;
+            std::unique_ptr<uint8_t[]> rxSlab;
+            std::size_t rxSlabUsed = 0;
+            std::array<FrameSegment, MAX_PACKETS> rxFrames;
+            std::array<ErrorCode, MAX_PACKETS> statuses;
+            std::array<ExpectedPayloadData, MAX_PACKETS> types;
+            std::size_t rxCount = 0;
+            std::vector<uint8_t> stream;
+            StreamReassembler reassembler;
+    };
+
+    /**
+     * @brief Split a stream into fragments the way the device does for a video request
+     */
+    void buildFragments(const std::vector<uint8_t>& encoded, uint16_t streamId,
+                        std::vector<uint8_t>& fragments, std::vector<std::span<const uint8_t>>& chunks) {
+
+        // Initialize method variables
+        std::size_t fragmentCount = (encoded.size() + FragmentHeader::MAX_DATA_SIZE - 1) / FragmentHeader::MAX_DATA_SIZE;
+        uint8_t *fragmentStart = nullptr;
+
+        fragments.resize(fragmentCount * FragmentHeader::SIZE + encoded.size());
+        chunks.clear();
+        fragmentStart = fragments.data();
+
+        for (std::size_t sequence = 0; sequence < fragmentCount; ++sequence) {
+            std::size_t offset = sequence * FragmentHeader::MAX_DATA_SIZE;
+            std::size_t chunkSize = std::min(FragmentHeader::MAX_DATA_SIZE, encoded.size() - offset);
+
+            FragmentHeader fragment;
+            fragment.streamId = streamId;
+            fragment.sequenceNumber = static_cast<uint32_t>(sequence);
+            fragment.fragmentOffset = static_cast<uint32_t>(offset);
+            fragment.lastFragment = (sequence + 1 == fragmentCount);
+            fragment.write(fragmentStart);
+            std::memcpy(fragmentStart + FragmentHeader::SIZE, encoded.data() + offset, chunkSize);
+
+            chunks.emplace_back(fragmentStart, FragmentHeader::SIZE + chunkSize);
+            fragmentStart += FragmentHeader::SIZE + chunkSize;
+        }
+    }
+
+    /**
+     * @brief Send the whole stream and drive the driver and receiver in lockstep, as main does, until it arrived
+     *
+     * @return double: milliseconds from the first fragment handed to the driver until the stream was reassembled
+     */
+    double transferStream(EthernetDriver& driver, EmbeddedDevice& device, StreamReceiver& receiver,
+                          const std::vector<uint8_t>& encoded, uint16_t streamId) {
+
+        // Initialize method variables
+        std::vector<uint8_t> fragments;
+        std::vector<std::span<const uint8_t>> chunks;
+
+        buildFragments(encoded, streamId, fragments, chunks);
+        receiver.reset();
+
+        Bench::Clock::time_point start = Bench::Clock::now();
+        device.sendFrames(chunks);
+        while (!receiver.isComplete()) {
+            driver.processStoredFrame();
+            receiver.processReceivedFrames();
+        }
+        std::chrono::duration<double, std::milli> elapsed = Bench::Clock::now() - start;
+
+        if (receiver.streamSize() != encoded.size()) {
+            std::printf("video_transfer: received %zu of %zu stream bytes\n", receiver.streamSize(), encoded.size());
+        }
+        return elapsed.count();
+    }
+}
+
+int main() {
+
+    // Initialize method variables
+    std::vector<uint8_t> encoded(STREAM_SIZE);
+    std::size_t fragmentCount = (STREAM_SIZE + FragmentHeader::MAX_DATA_SIZE - 1) / FragmentHeader::MAX_DATA_SIZE;
+    uint16_t streamId = 0;
+    char variant[64];
+
+    for (std::size_t i = 0; i < encoded.size(); ++i) {
+        encoded[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+    }
+
+    std::printf("Video transfer of %zu MB, %zu byte max payload: %zu frames of %zu stream bytes\n",
+                STREAM_SIZE >> 20, EthernetFrame::MAX_PAYLOAD_SIZE, fragmentCount, FragmentHeader::MAX_DATA_SIZE);
+
+    // In process: the cost is per frame, so fewer larger frames move the stream faster
+    {
+        EthernetDriver driver;
+        EmbeddedDevice device(&driver, DEVICE_ADDRESS);
+        StreamReceiver receiver(&driver, RECEIVER_ADDRESS);
+        double best = 0.0;
+
+        device.setDestinationAddress(RECEIVER_ADDRESS);
+        for (int run = 0; run < 5; ++run) {
+            double elapsed = transferStream(driver, device, receiver, encoded, streamId++);
+            best = (run == 0) ? elapsed : std::min(best, elapsed);
+        }
+
+        std::snprintf(variant, sizeof(variant), "in process, %zu B payload", EthernetFrame::MAX_PAYLOAD_SIZE);
+        Bench::report("video_transfer", variant, best, "ms");
+        Bench::report("video_transfer", variant, STREAM_SIZE * 8 / (best * 1e6), "Gbit/s");
+    }
+
+    // Over an emulated 1 Gbit/s link: the header, FCS, fragment header and per frame wire overhead set the goodput
+    {
+        EthernetDriver driver;
+        EmbeddedDevice device(&driver, DEVICE_ADDRESS);
+        StreamReceiver receiver(&driver, RECEIVER_ADDRESS);
+        LinkParameters parameters;
+
+        parameters.bitRate = 1000000000;
+        driver.setLink(RECEIVER_ADDRESS, parameters);
+        device.setDestinationAddress(RECEIVER_ADDRESS);
+        double elapsed = transferStream(driver, device, receiver, encoded, streamId++);
+
+        std::snprintf(variant, sizeof(variant), "1 Gbit/s link, %zu B payload", EthernetFrame::MAX_PAYLOAD_SIZE);
+        Bench::report("video_transfer", variant, elapsed, "ms");
+        std::snprintf(variant, sizeof(variant), "1 Gbit/s link goodput, %zu B payload", EthernetFrame::MAX_PAYLOAD_SIZE);
+        Bench::report("video_transfer", variant, STREAM_SIZE * 8 / (elapsed * 1e6) * 1000.0, "Mbit/s");
+    }
+
+    return 0;
+}
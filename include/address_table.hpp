@@ -0,0 +1,142 @@
+/**
+ * @file address_table.hpp
+ *
+ * @brief Declaration of the flat open addressing table that maps frame addresses to values
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_ADDRESS_TABLE_HPP__
+#define EDS_ADDRESS_TABLE_HPP__
+
+// Standard Includes
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Hash table from a 32 bit address to a value, laid out flat. The
+     * probe array holds only (address, value index) pairs, 8 bytes each, so a
+     * lookup walks a few neighbouring slots of one cache line instead of
+     * chasing list nodes; the values live densely in insertion order. Linear
+     * probing, power of two capacity, kept at most half full. Values are only
+     * added, never removed, and inserting may move them: pointers returned by
+     * find stay valid until the generation changes
+     */
+    template <typename Value>
+    class AddressTable {
+        public:
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            AddressTable() : slots(MIN_CAPACITY) {}
+
+            /**
+             * @brief Value stored for an address
+             *
+             * @return Value *: value, NULL when the address was never inserted
+             */
+            Value *find(uint32_t address) {
+                return const_cast<Value *>(std::as_const(*this).find(address));
+            }
+
+            const Value *find(uint32_t address) const {
+                std::size_t mask = slots.size() - 1;
+                for (std::size_t i = hash(address); ; i = (i + 1) & mask) {
+                    const Slot& slot = slots[i];
+                    if (slot.index == EMPTY) {
+                        return nullptr;
+                    }
+                    if (slot.address == address) {
+                        return &values[slot.index - 1];
+                    }
+                }
+            }
+
+            /**
+             * @brief Value stored for an address, default constructed on first use
+             */
+            Value& insert(uint32_t address) {
+                if (Value *value = find(address)) {
+                    return *value;
+                }
+
+                // Keep probe sequences short: grow before the table is half full
+                if (2 * (values.size() + 1) > slots.size()) {
+                    rehash(2 * slots.size());
+                }
+
+                values.emplace_back();
+                place(address, values.size());
+                generation++;
+                return values.back();
+            }
+
+            std::size_t size() const { return values.size(); }
+            uint64_t getGeneration() const { return generation; }
+            /**
+             * @}
+             */
+
+        private:
+            // Probe entry: the address and the index of its value plus one (0 marks an empty slot)
+            struct Slot {
+                uint32_t address = 0;
+                uint32_t index = EMPTY;
+            };
+
+            /**
+             * @defgroup Private constant declarations
+             * @{
+             */
+            static constexpr uint32_t EMPTY = 0;
+            static constexpr std::size_t MIN_CAPACITY = 16;
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            std::vector<Slot> slots;
+            std::vector<Value> values;
+            uint64_t generation = 0;
+            /**
+             * @}
+             */
+
+            // Fibonacci hash; the top bits are the well mixed ones
+            std::size_t hash(uint32_t address) const {
+                uint64_t mixed = static_cast<uint64_t>(address) * 0x9E3779B97F4A7C15ull;
+                return static_cast<std::size_t>(mixed >> 32) & (slots.size() - 1);
+            }
+
+            void place(uint32_t address, std::size_t index) {
+                std::size_t mask = slots.size() - 1;
+                std::size_t i = hash(address);
+                while (slots[i].index != EMPTY) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = {address, static_cast<uint32_t>(index)};
+            }
+
+            void rehash(std::size_t capacity) {
+                std::vector<Slot> previous(capacity);
+                previous.swap(slots);
+                for (const Slot& slot : previous) {
+                    if (slot.index != EMPTY) {
+                        place(slot.address, slot.index);
+                    }
+                }
+            }
+    };
+};
+
+#endif // EDS_ADDRESS_TABLE_HPP__
@@ -0,0 +1,177 @@
+/**
+ * @file driver_statistics.hpp
+ *
+ * @brief Declaration of the driver's per thread statistics counters and their snapshot
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_DRIVER_STATISTICS_HPP__
+#define EDS_DRIVER_STATISTICS_HPP__
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Project Includes
+#include "frame_ring.hpp"
+#include "latency_histogram.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Enumeration to hold why the driver dropped a frame
+    enum class DropReason : uint8_t {
+        QUEUE_FULL = 0,           // Refused by a full queue and not retried by the driver
+        MALFORMED_FRAME,          // Refused at enqueue: larger than a frame
+        UNKNOWN_DESTINATION,      // Forwarded to an address nobody registered
+
+        COUNT
+    };
+
+    inline constexpr std::size_t DROP_REASON_COUNT = static_cast<std::size_t>(DropReason::COUNT);
+
+    /**
+     * @brief Counter with a single writer thread. The writer adds with a relaxed
+     * load and store, so counting costs no locked instruction; any thread may
+     * read it at any time and sees a recent value
+     */
+    class StatisticsCounter {
+        public:
+            void add(uint64_t amount) {
+                value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+
+            void raiseTo(uint64_t candidate) {
+                if (candidate > value.load(std::memory_order_relaxed)) {
+                    value.store(candidate, std::memory_order_relaxed);
+                }
+            }
+
+            uint64_t read() const { return value.load(std::memory_order_relaxed); }
+
+        private:
+            std::atomic<uint64_t> value{0};
+    };
+
+    // Counters kept by one sending (or processing) thread; on its own cache line so threads never false share
+    struct alignas(CACHE_LINE_SIZE) SenderStatistics {
+        StatisticsCounter framesEnqueued;
+        StatisticsCounter bytesEnqueued;
+        StatisticsCounter enqueueStalls;
+        std::array<StatisticsCounter, DROP_REASON_COUNT> framesDropped;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        LatencyHistogram processLatency;      // Forwarded until the receiver processed the frame
+#endif
+    };
+
+    // Counters kept by the one consumer of a queue
+    struct alignas(CACHE_LINE_SIZE) QueueStatistics {
+        StatisticsCounter framesForwarded;
+        StatisticsCounter bytesForwarded;
+        StatisticsCounter creditStalls;
+        StatisticsCounter unknownDestinations;
+        StatisticsCounter highWaterMark;      // Most frames seen waiting at once
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        LatencyHistogram forwardLatency;      // Stored until forwarded to the receiver
+#endif
+    };
+
+    // Structure to hold the totals of one (source, destination) flow
+    struct FlowStatistics {
+        uint32_t sourceAddress;
+        uint32_t destinationAddress;
+        uint64_t frames;
+        uint64_t bytes;
+    };
+
+    /**
+     * @brief Fixed capacity open addressing table of flow totals, written by a
+     * queue's consumer only. Entries are never moved or removed, so readers can
+     * walk it while the consumer counts; flows that find no entry within
+     * MAX_PROBES slots are added to the untracked totals, so a table full of
+     * other flows costs a bounded probe rather than a walk of every entry
+     */
+    class FlowStatisticsTable {
+        public:
+            static constexpr std::size_t CAPACITY = 256;
+            static constexpr std::size_t MAX_PROBES = 16;
+
+            // Structure to hold one flow's counters
+            struct Entry {
+                std::atomic<bool> used{false};
+                uint32_t sourceAddress = 0;
+                uint32_t destinationAddress = 0;
+                StatisticsCounter frames;
+                StatisticsCounter bytes;
+            };
+
+            /**
+             * @brief Entry of a flow, claimed on first use
+             *
+             * @return Entry *: entry, NULL when no entry is free within MAX_PROBES slots
+             */
+            Entry *find(uint32_t sourceAddress, uint32_t destinationAddress) {
+                uint64_t flow = ((static_cast<uint64_t>(sourceAddress) << 32) | destinationAddress) * 0x9E3779B97F4A7C15ull;
+                std::size_t index = static_cast<std::size_t>(flow >> 32) % CAPACITY;
+
+                for (std::size_t probe = 0; probe < MAX_PROBES; ++probe, index = (index + 1) % CAPACITY) {
+                    Entry& entry = entries[index];
+                    if (!entry.used.load(std::memory_order_relaxed)) {
+                        // Publish the addresses before readers may look at the entry
+                        entry.sourceAddress = sourceAddress;
+                        entry.destinationAddress = destinationAddress;
+                        entry.used.store(true, std::memory_order_release);
+                        return &entry;
+                    }
+                    if (entry.sourceAddress == sourceAddress && entry.destinationAddress == destinationAddress) {
+                        return &entry;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            /**
+             * @brief Append the totals of every flow seen so far
+             */
+            void collect(std::vector<FlowStatistics>& flows) const {
+                for (const Entry& entry : entries) {
+                    if (entry.used.load(std::memory_order_acquire)) {
+                        flows.push_back({entry.sourceAddress, entry.destinationAddress, entry.frames.read(), entry.bytes.read()});
+                    }
+                }
+            }
+
+            StatisticsCounter untrackedFrames;
+            StatisticsCounter untrackedBytes;
+
+        private:
+            std::array<Entry, CAPACITY> entries;
+    };
+
+    // Structure to hold a snapshot of every driver counter, summed over the threads and queues
+    struct DriverStatistics {
+        uint64_t framesEnqueued = 0;
+        uint64_t bytesEnqueued = 0;
+        uint64_t framesForwarded = 0;
+        uint64_t bytesForwarded = 0;
+        uint64_t enqueueStalls = 0;
+        uint64_t creditStalls = 0;
+        std::array<uint64_t, DROP_REASON_COUNT> framesDropped = {};
+        std::vector<uint64_t> queueHighWaterMarks;     // Per queue
+        std::vector<FlowStatistics> flows;             // Per (source, destination) pair
+        uint64_t untrackedFlowFrames = 0;              // Flows beyond the per queue flow table
+        uint64_t untrackedFlowBytes = 0;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        LatencyDistribution forwardLatency;            // See LATENCY_HISTOGRAMS in the Makefile
+        LatencyDistribution processLatency;
+#endif
+    };
+};
+
+#endif // EDS_DRIVER_STATISTICS_HPP__
@@ -13,6 +13,12 @@
 // Standard Includes
 #include <string>
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 #include <cstdint>
 
@@ -33,7 +39,7 @@ namespace EthernetDriverSimulation
              * @defgroup Public constant declarations
              * @{
              */
-            static constexpr size_t RX_BUFFER_SIZE = 8192;
+            static constexpr size_t RX_BUFFER_SIZE = EthernetFrame::BUFFER_SIZE;
             static constexpr size_t MAX_PACKETS = RX_BUFFER_SIZE / EthernetFrame::MAX_FRAME_SIZE;
             /**
              * @}
@@ -47,9 +53,13 @@ namespace EthernetDriverSimulation
             ~EmbeddedDevice() = default;
 
             void clearRxBuffer();
+            bool waitForReceivedFrames(std::chrono::milliseconds timeout);
             void receiveFrame(const uint8_t *data, size_t size) override;
-            void sendFrame(const std::vector<uint8_t>& payload);
+            void receiveFrames(std::span<const FrameRef> frames) override;
+            ErrorCode sendFrame(const std::vector<uint8_t>& payload);
+            ErrorCode sendFrames(std::span<const std::span<const uint8_t>> payloads, EthernetDriver::TxCompletion onComplete = {});
             void setDestinationAddress(uint32_t address);
+            void setFrameCheckSequence(bool enabled);
 
             ErrorCode processReceivedFrames();
 
@@ -57,7 +67,22 @@ namespace EthernetDriverSimulation
              * @}
              */
         private:
-        
+            // Structure to locate a received frame inside the rx slab
+            struct ReceivedFrame {
+                std::size_t offset;
+                std::size_t length;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                uint64_t forwardedAt = 0;   // LatencyClock time the driver handed the frame over
+#endif
+            };
+
+            // Structure to hold a batch of received frames and the slab backing their bytes
+            struct RxBuffer {
+                std::unique_ptr<uint8_t[]> slab;          // RX_BUFFER_SIZE bytes, filled up to slabUsed
+                std::size_t slabUsed = 0;
+                std::vector<ReceivedFrame> frames;
+            };
+
             /**
              * @defgroup Private constant definitions
              * @{
@@ -74,8 +99,18 @@ namespace EthernetDriverSimulation
              */
             EthernetDriver* driver;
             uint32_t address;
-            std::vector<std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE>> rxBuffer;
+            std::mutex rxLock;                            // Guards rxFilling, which the driver's worker may fill
+            std::condition_variable rxSignal;             // Raised when frames land in rxFilling
+            RxBuffer rxFilling;                           // Filled by receiveFrames
+            RxBuffer rxProcessing;                        // Owned by processReceivedFrames
+            std::vector<FrameSegment> rxFrames;
+            std::vector<ErrorCode> rxFrameStatuses;
+            std::vector<ExpectedPayloadData> rxFrameTypes;
             uint32_t destinationAddress;
+            bool frameCheckSequenceEnabled = true;
+            uint16_t videoStreamId = 0;
+            std::vector<uint8_t> videoFragments;            // Backs the payloads of the video transmission
+            std::atomic<bool> videoTransmitting{false};     // Until the driver has stored every fragment
             /**
              * @}
              */
@@ -84,7 +119,8 @@ namespace EthernetDriverSimulation
              * @defgroup Private Function declarations
              * @{
              */
-            const std::vector<uint8_t> convertEnumToBytes(ExpectedPayloadData data);
+            void sendControlFrame(ExpectedPayloadData data);
+            void releaseRxBuffer();
             /**
              * @}
              */
@@ -24,6 +24,8 @@ namespace EthernetDriverSimulation
 
         MALFORMED_FRAME = 0x1000,
         INVALID_ETHER_TYPE = 0x1001,
+        FCS_MISMATCH = 0x1002,
+        FRAGMENT_GAP = 0x1003,
 
         ETHERNET_BUFFER_FULL = 0x2000,
         HOST_BUFFER_FULL = 0x2001,
@@ -50,6 +52,11 @@ namespace EthernetDriverSimulation
         DECODE_ENCODER_OPEN_FAIL = 0x5006,
         DECODE_CANNOT_OPEN_OUTPUT = 0x5007,
         DECODE_HEADER_WRITE_FAIL = 0x5008,
+
+        TRANSPORT_OPEN_FAILED = 0x6000,
+        TRANSPORT_NOT_READY = 0x6001,
+        TRANSPORT_MISMATCH = 0x6002,
+        TRANSPORT_NOT_SUPPORTED = 0x6003,
     };
 
     /**
@@ -66,6 +73,8 @@ namespace EthernetDriverSimulation
 
             case ErrorCode::MALFORMED_FRAME: return "Malformed Packet";
             case ErrorCode::INVALID_ETHER_TYPE: return "Invalid Ethernet Type";
+            case ErrorCode::FCS_MISMATCH: return "Frame Check Sequence Mismatch";
+            case ErrorCode::FRAGMENT_GAP: return "Missing Stream Fragment";
 
             case ErrorCode::ETHERNET_BUFFER_FULL: return "Ethernet Buffer Overflow";
 
@@ -92,6 +101,11 @@ namespace EthernetDriverSimulation
             case ErrorCode::DECODE_ENCODER_OPEN_FAIL: return "Could not open/use decoder";
             case ErrorCode::DECODE_CANNOT_OPEN_OUTPUT: return "Could not open output file when decoding";
             case ErrorCode::DECODE_HEADER_WRITE_FAIL: return "Failed to write header for decoding";
+
+            case ErrorCode::TRANSPORT_OPEN_FAILED: return "Could not open the transport";
+            case ErrorCode::TRANSPORT_NOT_READY: return "Transport peer not ready yet";
+            case ErrorCode::TRANSPORT_MISMATCH: return "Transport peer built with another layout";
+            case ErrorCode::TRANSPORT_NOT_SUPPORTED: return "Transport not supported on this platform";
             
             default: return "INVALID ERROR";
         }
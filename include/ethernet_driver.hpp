@@ -12,18 +12,52 @@
 #define EDS_ETHERNET_DRIVER_HPP__
 
 // Standard Includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <cstdint>
-#include <unordered_map>
 
 // Project Includes
+#include "address_table.hpp"
+#include "driver_statistics.hpp"
 #include "error_code.hpp"
 #include "ethernet_frame.hpp"
+#include "frame_queue.hpp"
+#include "link_model.hpp"
 #include "packet_receiver.hpp"
+#include "timing_wheel.hpp"
 
 // Declare namespace
 namespace EthernetDriverSimulation
 {
+    // Structure to hold when a queue's waiting frames are delivered (interrupt coalescing)
+    struct CoalescingParameters {
+        std::size_t frameThreshold = 1;              // Deliver once this many frames are waiting
+        std::chrono::microseconds timeThreshold{0};  // Or once the first waiting frame has waited this long
+    };
+
+    // Structure to hold the flow control counters
+    struct FlowControlStatistics {
+        uint64_t framesDropped;   // Refused because their queue was full (XOFF) and not retried by the driver
+        uint64_t enqueueStalls;   // Times a blocking or async enqueue had to wait for XON
+        uint64_t creditStalls;    // Times forwarding waited for a receiver to grant credit
+    };
+
+    /**
+     * @brief Simulated driver: any number of threads store frames into bounded
+     * queues, which are forwarded in order per flow to the registered receivers
+     */
     class EthernetDriver {
         public:
 
@@ -31,8 +65,13 @@ namespace EthernetDriverSimulation
              * @defgroup Public constant declarations
              * @{
              */
-            static constexpr size_t MAX_BUFFER_SIZE = 8192;
-            static constexpr size_t MAX_BUFFERED_FRAMES = MAX_BUFFER_SIZE / EthernetFrame::MAX_FRAME_SIZE;
+            static constexpr size_t MAX_BUFFER_SIZE = EthernetFrame::BUFFER_SIZE;
+            static constexpr size_t MAX_BUFFERED_FRAMES = MAX_BUFFER_SIZE / EthernetFrame::MAX_FRAME_SIZE; // Per queue
+            static constexpr size_t BATCH_HISTOGRAM_SIZE = MAX_BUFFERED_FRAMES + 1; // Batch sizes 0 .. MAX_BUFFERED_FRAMES (or more)
+            static constexpr size_t UNLIMITED_CREDIT = std::numeric_limits<std::size_t>::max();     // Receiver without flow control
+            static constexpr uint32_t BROADCAST_ADDRESS = 0xFFFFFFFF;                                // Delivered to every registered receiver
+            static constexpr size_t LINK_IN_FLIGHT_FRAMES = 1024;                                     // Per queue, once a link is set
+            static constexpr std::chrono::nanoseconds TIMER_RESOLUTION{1000};                         // Timers fire on whole ticks of this
             /**
              * @}
              */
@@ -41,24 +80,299 @@ namespace EthernetDriverSimulation
              * @defgroup Public function declarations
              * @{
              */
-            EthernetDriver();
-            ~EthernetDriver() = default;
+            // Raised with the queue index when a coalesced queue is due; runs on the thread servicing the queue
+            using InterruptHandler = std::function<void(std::size_t)>;
+            using BatchHistogram = std::array<uint64_t, BATCH_HISTOGRAM_SIZE>;
+
+            // Raised once (XON) after a queue that refused frames frees a slot; runs on the thread servicing the queue
+            using XonCallback = std::function<void()>;
+
+            // Raised once every frame of a transmission is stored (or it failed) with the frames stored; its buffers may then be reused
+            using TxCompletion = std::function<void(ErrorCode, std::size_t)>;
+
+            // Raised once a timer expires; runs on the thread servicing the driver (worker 0, or the caller of processStoredFrame)
+            using TimerId = TimingWheel::TimerId;
+            using TimerCallback = TimingWheel::Callback;
+
+            /**
+             * @brief Create the driver with its frame queues. With more than one queue
+             * (RSS style) each frame is hashed by its (source, destination) pair to
+             * a queue, so the frames of a flow stay in order
+             */
+            explicit EthernetDriver(std::size_t queueCount = 1);
+            ~EthernetDriver();
+
+            ErrorCode storeSerializedFrame(const uint8_t* frameData, std::size_t size);
+            ErrorCode storeSerializedFrame(std::span<const FrameSegment> segments);
+            ErrorCode storeSerializedFrames(std::span<const FramePayload> payloads, std::size_t& framesStored);
+
+            /**
+             * @brief Store every payload, waiting for XON whenever a queue is full.
+             * With workers running it sleeps until one frees a slot of the full
+             * queue; otherwise it forwards the full queue on the calling thread,
+             * which must then be the thread that calls processStoredFrame
+             *
+             * @param[in] payloads - span<const FramePayload>: payloads to frame and store
+             *
+             * @return ErrorCode: ETHERNET_BUFFER_FULL when no worker runs and the receivers have no credit left
+             */
+            ErrorCode storeSerializedFramesBlocking(std::span<const FramePayload> payloads);
+
+            /**
+             * @brief Store as many payloads as fit. When a queue is full the callback
+             * is kept and raised once that queue frees a slot, so the caller resumes
+             * from framesStored instead of dropping the rest. It may also be raised
+             * when the slot was freed while it was being registered
+             *
+             * @param[in] payloads - span<const FramePayload>: payloads to frame and store
+             * @param[out] framesStored - size_t&: payloads stored
+             * @param[in] onXon - XonCallback: resumes the caller; not kept when everything was stored
+             *
+             * @return ErrorCode: ETHERNET_BUFFER_FULL (XOFF) when the callback was kept
+             */
+            ErrorCode storeSerializedFramesAsync(std::span<const FramePayload> payloads, std::size_t& framesStored, XonCallback onXon);
+
+            /**
+             * @brief Hand a whole transmission to the driver. The payload
+             * descriptors are copied, but the bytes they point to must stay valid
+             * until completion. Frames are stored in submission order, as queue
+             * space allows, by the service thread (or processStoredFrame); what
+             * fits straight away is stored before returning
+             *
+             * @param[in] payloads - span<const FramePayload>: payloads to frame and store
+             * @param[in] onComplete - TxCompletion: raised on the thread that stores the last frame
+             */
+            void transmit(std::span<const FramePayload> payloads, TxCompletion onComplete);
+
+            /**
+             * @brief Hand a whole transmission to the driver (see above)
+             *
+             * @return future<ErrorCode>: ready once the payload buffers may be reused
+             */
+            std::future<ErrorCode> transmit(std::span<const FramePayload> payloads);
+
+            /**
+             * @brief Register the receiver of an address. A receiver registered with
+             * credits is only forwarded as many frames as it has granted; the rest
+             * wait in order in their queue. It must hand each credit back with
+             * grantCredit once it has consumed the frame (its rx buffer space).
+             * Receivers must be registered before any worker starts
+             */
+            void registerReceiver(uint32_t address, PacketReceiver* receiver, std::size_t credits = UNLIMITED_CREDIT);
+            void grantCredit(uint32_t address, std::size_t credits);
+
+            /**
+             * @brief Add a registered receiver to a group address. Frames sent to the
+             * group (or BROADCAST_ADDRESS) are handed to every member but the sender
+             * straight from the queue slot, which is released once every member had
+             * it, so fan out never copies the frame. Membership must change while
+             * no worker is running
+             *
+             * @param[in] groupAddress - uint32_t: group address; must not be a receiver's or the broadcast address
+             * @param[in] memberAddress - uint32_t: address of a registered receiver
+             *
+             * @return ErrorCode: INVALID_INPUT for a unicast or broadcast group address, INVALID_RECEIVER for an unknown member
+             */
+            ErrorCode joinGroup(uint32_t groupAddress, uint32_t memberAddress);
+            ErrorCode leaveGroup(uint32_t groupAddress, uint32_t memberAddress);
+            bool hasStoredFrames();
+            bool hasFramesInFlight() const;
+
+            /**
+             * @brief Put an emulated link in front of a receiver, replacing any link it
+             * had. Frames to it leave their queue when they go on the wire and are
+             * handed over by the queue's consumer once serialization, propagation
+             * delay and jitter have passed, so hasStoredFrames stays true until
+             * they arrived. Must be called while no worker is running
+             *
+             * @param[in] address - uint32_t: address of a registered receiver
+             * @param[in] parameters - LinkParameters: bit rate, delay and jitter of the link
+             *
+             * @return ErrorCode: INVALID_RECEIVER when no receiver has the address
+             */
+            ErrorCode setLink(uint32_t address, const LinkParameters& parameters);
+
+            /**
+             * @brief What a receiver's link delivered so far, and its goodput against the configured bit rate
+             *
+             * @return ErrorCode: INVALID_RECEIVER when the address has no link
+             */
+            ErrorCode getLinkStatistics(uint32_t address, LinkStatistics& statistics) const;
+
+            /**
+             * @brief Run a callback once a delay has passed (rounded up to whole
+             * TIMER_RESOLUTION ticks of a hierarchical timing wheel). Any thread may schedule, reschedule or cancel
+             * timers, callbacks included; each costs the same whatever the number
+             * of pending timers
+             *
+             * @param[in] delay - nanoseconds: time from now until the callback runs
+             * @param[in] callback - TimerCallback: runs on the thread servicing the driver
+             *
+             * @return TimerId: id to reschedule or cancel the timer with
+             */
+            TimerId scheduleTimer(std::chrono::nanoseconds delay, TimerCallback callback);
 
-            ErrorCode storeSerializedFrame(const uint8_t* frameData);
-            
-            void registerReceiver(uint32_t address, PacketReceiver* receiver);
+            /**
+             * @brief Move a pending timer to fire a delay from now
+             *
+             * @return bool: false when the timer already fired or was cancelled
+             */
+            bool rescheduleTimer(TimerId timer, std::chrono::nanoseconds delay);
+            bool cancelTimer(TimerId timer);
             void processStoredFrame();
+
+            /**
+             * @brief Take the queues over from processStoredFrame with pinned worker
+             * threads: one per queue, or a single TX/RX service thread for all of
+             * them. Workers sleep while nothing can make progress, until work
+             * arrives or the next timer, link arrival or coalescing deadline is
+             * due. A receiver that gets several flows may then be called from
+             * several threads
+             *
+             * @param[in] workerCount - size_t: worker threads; 0 for one per queue
+             */
+            void startWorkers(std::size_t workerCount = 0);
+            void startServiceThread() { startWorkers(1); }
+            void stopWorkers();
+            std::size_t getQueueCount() const { return frameQueues.size(); }
+
+            /**
+             * @brief Set the coalescing thresholds (NAPI style) and the optional
+             * interrupt handler: a queue is only serviced once enough frames wait
+             * or the first of them has waited long enough, and the handler may
+             * then poll it with a budget. Must be called while no worker is running
+             *
+             * @param[in] parameters - CoalescingParameters: delivery thresholds (frameThreshold is capped to MAX_BUFFERED_FRAMES)
+             * @param[in] handler - InterruptHandler: polls a due queue; empty to let the driver deliver the batch
+             */
+            void setCoalescing(const CoalescingParameters& parameters, InterruptHandler handler = {});
+
+            /**
+             * @brief Forward at most budget waiting frames of one queue, ignoring the
+             * coalescing thresholds. Call it from the interrupt handler, or from the
+             * thread calling processStoredFrame while no worker is running
+             *
+             * @param[in] queueIndex - size_t: queue to poll
+             * @param[in] budget - size_t: most frames to forward
+             *
+             * @return size_t: frames forwarded; less than budget means the queue ran dry
+             */
+            std::size_t pollQueue(std::size_t queueIndex, std::size_t budget);
+
+            /**
+             * @brief Number of delivered batches per batch size, summed over the queues.
+             * Index 0 counts polls that found nothing; the last index counts batches
+             * of MAX_BUFFERED_FRAMES or more
+             */
+            BatchHistogram getBatchHistogram() const;
+            FlowControlStatistics getFlowControlStatistics() const;
+
+            /**
+             * @brief Fill a snapshot of every counter, summed over the sending threads
+             * and the queues. Counters are only read, never reset or locked, so it
+             * can be taken often while frames flow; reuse the snapshot to avoid
+             * allocating
+             *
+             * @param[out] snapshot - DriverStatistics&: counters at about this moment
+             */
+            void getStatistics(DriverStatistics& snapshot) const;
+
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            /**
+             * @brief Record how long a receiver took to process a frame after it was
+             * forwarded (LatencyClock time at receiveFrame until processing)
+             *
+             * @param[in] nanoseconds - uint64_t: forward to process latency
+             */
+            void recordProcessLatency(uint64_t nanoseconds);
+#endif
             /**
              * @}
              */
 
         private:
+            using FrameStore = FrameQueue<EthernetFrame::MAX_FRAME_SIZE, MAX_BUFFERED_FRAMES>;
+
+            struct ReceiverEntry;
+
+            using LinkDelayLine = DelayLine<EthernetFrame::MAX_FRAME_SIZE>;
+
+            // Structure to hold one receive queue and the coalescing state of its consumer
+            struct ReceiveQueue {
+                FrameStore frames;
+                bool framesWaiting = false;
+                std::chrono::steady_clock::time_point waitingSince;
+                std::array<std::atomic<uint64_t>, BATCH_HISTOGRAM_SIZE> batchHistogram{};
+                QueueStatistics statistics;
+                FlowStatisticsTable flows;
+                FlowStatisticsTable::Entry *lastFlow = nullptr;
+                std::size_t membersServed = 0;               // Group members already handed the front frame
+                uint32_t lastDestination = 0;                // Last destination cache of the forwarding path
+                ReceiverEntry *lastReceiver = nullptr;
+                uint64_t lastGeneration = 0;
+                std::atomic<bool> xoff{false};
+                std::mutex xonLock;
+                std::vector<XonCallback> xonWaiters;
+                LinkDelayLine delayLine;                     // Frames sent from this queue over an emulated link
+                std::minstd_rand jitterSource;
+                std::array<FrameRef, MAX_BUFFERED_FRAMES> deliveries;   // Frames for deliveryReceiver, handed over in one call
+                std::size_t deliveryCount = 0;
+                PacketReceiver *deliveryReceiver = nullptr;
+            };
+
+            // Structure to hold a transmission waiting for queue space
+            struct TransmitRequest {
+                std::vector<FramePayload> payloads;
+                std::size_t framesStored = 0;
+                ErrorCode status = ErrorCode::SUCCESS;
+                TxCompletion onComplete;
+            };
+
+            // Structure to hold a registered receiver and the credits it has granted, or a group and its members
+            struct ReceiverEntry {
+                PacketReceiver* receiver = nullptr;
+                bool creditLimited = false;
+                std::atomic<std::size_t> credits{0};
+                bool group = false;
+                std::vector<uint32_t> members;
+                std::unique_ptr<LinkModel> link;             // Emulated link in front of the receiver, if any
+
+                ReceiverEntry() = default;
+
+                // The table moves entries while it grows, which only happens while registering
+                ReceiverEntry(ReceiverEntry&& other) noexcept
+                    : receiver(other.receiver),
+                      creditLimited(other.creditLimited),
+                      credits(other.credits.load(std::memory_order_relaxed)),
+                      group(other.group),
+                      members(std::move(other.members)),
+                      link(std::move(other.link)) {}
+            };
+
             /**
              * @defgroup Private variable declarations
              * @{
              */
-            std::unordered_map<uint32_t, PacketReceiver*> addressToReceiverMap;
-            std::vector<std::vector<uint8_t>> frameBuffer;
+            AddressTable<ReceiverEntry> addressToReceiverMap;
+            std::vector<std::unique_ptr<ReceiveQueue>> frameQueues;
+            CoalescingParameters coalescing;
+            InterruptHandler interruptHandler;
+            std::vector<std::thread> workers;
+            std::atomic<bool> workersRunning{false};
+            std::atomic<bool> workersOwnQueues{false};    // From startWorkers until stopWorkers has joined them
+            std::atomic<uint32_t> doorbell{0};            // Rung when work arrives for sleeping workers
+            std::atomic<std::size_t> sleepingWorkers{0};
+            std::mutex doorbellLock;                      // Lets workers sleep until a deadline
+            std::condition_variable doorbellSignal;
+            std::mutex transmitLock;
+            std::deque<TransmitRequest> transmitRequests;
+            std::atomic<bool> transmitPending{false};
+            std::mutex timerLock;
+            TimingWheel timers;
+            std::atomic<uint64_t> nextTimerAt{TimingWheel::NEVER};  // Earliest time a timer may be due
+            uint64_t driverId;                            // Tells this driver's counters apart in the threads' caches
+            mutable std::mutex senderStatisticsLock;
+            std::vector<std::pair<std::thread::id, std::unique_ptr<SenderStatistics>>> senderStatistics;
             /**
              * @}
              */
@@ -67,7 +381,31 @@ namespace EthernetDriverSimulation
              * @defgroup Private function declarations
              * @{
              */
-            void forwardSerializedFrame(const std::vector<uint8_t>& frame);
+            std::size_t selectQueue(uint32_t destinationAddress, uint32_t sourceAddress) const;
+            std::size_t selectQueue(const uint8_t* frame, std::size_t size) const;
+            std::size_t selectQueue(const FramePayload& payload) const;
+            ErrorCode validatePayloads(std::span<const FramePayload> payloads);
+            ErrorCode enqueueFrames(std::span<const FramePayload> payloads, std::size_t& framesStored);      // Payloads already validated
+            std::size_t forwardQueue(ReceiveQueue& queue, std::size_t limit);
+            void signalXon(ReceiveQueue& queue);
+            void waitForXon(ReceiveQueue& queue);
+            bool takeCredit(ReceiveQueue& queue, ReceiverEntry& entry);
+            SenderStatistics& localStatistics();
+            void countForwarded(ReceiveQueue& queue, const uint8_t* frame, std::size_t size);
+            bool serviceQueue(std::size_t queueIndex);
+            void recordBatch(ReceiveQueue& queue, std::size_t batchSize);
+            bool serviceTransmit();
+            std::size_t serviceTimers();
+            void updateNextTimer();
+            bool serviceWorkerQueues(std::size_t workerIndex, std::size_t workerCount);
+            uint64_t nextDeadline(std::size_t workerIndex, std::size_t workerCount);
+            void ringDoorbell();
+            void runWorker(std::size_t workerIndex, std::size_t workerCount);
+            bool forwardSerializedFrame(ReceiveQueue& queue, const uint8_t* frame, std::size_t size);
+            bool deliverFrame(ReceiveQueue& queue, uint32_t address, ReceiverEntry& entry, const uint8_t* frame, std::size_t size);
+            std::size_t releaseArrivals(ReceiveQueue& queue);
+            void queueDelivery(ReceiveQueue& queue, PacketReceiver& receiver, const uint8_t* frame, std::size_t size);
+            void flushDeliveries(ReceiveQueue& queue);
             /**
              * @}
              */
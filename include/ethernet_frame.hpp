@@ -21,20 +21,67 @@
 
 // Project Includes
 #include "error_code.hpp"
+#include "frame_check_sequence.hpp"
+#include "frame_header_schema.hpp"
 
 // Declare namespace
 namespace EthernetDriverSimulation
 {
-    class EthernetFrame {
+    // Structure to reference one contiguous piece of a serialized frame (iovec style)
+    struct FrameSegment {
+        const uint8_t *data;
+        std::size_t length;
+    };
+
+    // Structure to describe one payload to be framed and enqueued as part of a batch
+    struct FramePayload {
+        std::array<uint8_t, 4> destinationAddress;
+        std::array<uint8_t, 4> sourceAddress;
+        const uint8_t *data;
+        std::uint16_t length;
+        bool frameCheckSequence = false;
+    };
+
+    /**
+     * @defgroup Frame size policies
+     * @{
+     */
+    // Original simulator frames: 1 KB payload
+    struct DefaultFrameSize {
+        static constexpr std::size_t MAX_PAYLOAD_SIZE = 1024;
+        static constexpr std::size_t BUFFER_SIZE      = 8192;
+    };
+
+    // Standard Ethernet MTU payload
+    struct StandardMtuFrameSize {
+        static constexpr std::size_t MAX_PAYLOAD_SIZE = 1500;
+        static constexpr std::size_t BUFFER_SIZE      = 12288;
+    };
+
+    // Jumbo frame payload
+    struct JumboFrameSize {
+        static constexpr std::size_t MAX_PAYLOAD_SIZE = 9000;
+        static constexpr std::size_t BUFFER_SIZE      = 65536;
+    };
+    /**
+     * @}
+     */
+
+    template <typename SizePolicy>
+    class BasicEthernetFrame {
         public:
             /**
              * @defgroup Public const class variables
              * @{
              */
-            static constexpr std::size_t   MAX_FRAME_SIZE   = 1040;
-            static constexpr std::size_t   MAX_PAYLOAD_SIZE = 1024;
-            static constexpr std::uint16_t EDS_ETHERTYPE    = 0xC0AF;
-            static constexpr std::uint16_t DELIMITER        = 0xABAB;
+            static constexpr std::size_t   MAX_PAYLOAD_SIZE = SizePolicy::MAX_PAYLOAD_SIZE;
+            static constexpr std::size_t   BUFFER_SIZE      = SizePolicy::BUFFER_SIZE; // Bytes of frame storage in drivers and receivers
+            static constexpr std::size_t   HEADER_SIZE      = FrameHeaderSchema::HEADER_SIZE;
+            static constexpr std::size_t   FCS_SIZE         = FrameHeaderSchema::FCS_SIZE;
+            static constexpr std::size_t   MAX_FRAME_SIZE   = HEADER_SIZE + MAX_PAYLOAD_SIZE + FCS_SIZE;
+            static constexpr std::uint16_t EDS_ETHERTYPE    = FrameHeaderSchema::EDS_ETHERTYPE;
+            static constexpr std::uint16_t DELIMITER        = FrameHeaderSchema::DELIMITER;
+            static constexpr std::uint16_t FCS_DELIMITER    = FrameHeaderSchema::FCS_DELIMITER;
             /**
              * @}
              */
@@ -47,6 +94,7 @@ namespace EthernetDriverSimulation
             std::array<uint8_t, 4>sourceAddress;
             std::array<uint8_t, MAX_PAYLOAD_SIZE> payload;
             std::uint16_t payloadLength = 0;
+            bool frameCheckSequence = false;
             /**
              * @}
              */
@@ -55,7 +103,7 @@ namespace EthernetDriverSimulation
              * @defgroup Public function declarations
              * @{
              */
-            EthernetFrame() = default;
+            BasicEthernetFrame() = default;
 
             /**
              * @brief Overloaded Constructor
@@ -65,7 +113,7 @@ namespace EthernetDriverSimulation
              * @param[in] data - uint8_t *
              * @param[in] length - uint16_t
              */
-            EthernetFrame(std::array<uint8_t, 4>dest, std::array<uint8_t, 4>source, const uint8_t *data, std::uint16_t length):
+            BasicEthernetFrame(std::array<uint8_t, 4>dest, std::array<uint8_t, 4>source, const uint8_t *data, std::uint16_t length):
                 destinationAddress(dest),
                 sourceAddress(source),
                 payloadLength(length)
@@ -82,40 +130,117 @@ namespace EthernetDriverSimulation
                 return "Ethernet Packet:\n\tDestination Address: 0x" + displayHex(destinationAddress) +
                     "\n\tSource Address: 0x" + displayHex(sourceAddress) +
                     "\n\tEtherType: 0x" + displayHex(EDS_ETHERTYPE) +
-                    "\n\tDelimiter: 0x" + displayHex(DELIMITER) +
+                    "\n\tDelimiter: 0x" + displayHex(frameCheckSequence ? FCS_DELIMITER : DELIMITER) +
                     "\n\tPayload Length: 0x" + displayHex(payloadLength) +
                     "\n\tPayload Data Start: 0x" + displayHex(payload[0]) + "...";
             }
 
             /**
-             * @brief function to convert frame to hex stream (serialize)
+             * @brief function to convert frame to hex stream (serialize) in caller provided storage
              * 
+             * @param[out] stream - array<uint8_t, MAX_FRAME_SIZE>&: storage for the serialized frame
              * @param[in] finalStreamSize - size_t&: pointer to size variable
              * 
              * @return uint8_t *: pointer to start of hex stream
              */
-            const uint8_t *toHexStream(std::size_t& finalStreamSize) const{
+            const uint8_t *toHexStream(std::array<uint8_t, MAX_FRAME_SIZE>& stream, std::size_t& finalStreamSize) const{
                 // Initalized Function Variables
                 std::size_t hexStreamSize = 0;
 
-                // Add Destination Address
-                std::memcpy(buffer_.data() + hexStreamSize, destinationAddress.data(), 4);
-                hexStreamSize+=4;
-
-                // Add Source Address
-                std::memcpy(buffer_.data() + hexStreamSize, sourceAddress.data(), 4);
-                hexStreamSize+=4;
-                
-                // Add Ether Type
-                writeUint16(buffer_, hexStreamSize, EDS_ETHERTYPE);
-                writeUint16(buffer_, hexStreamSize, static_cast<uint16_t>(payloadLength));
-                writeUint16(buffer_, hexStreamSize, DELIMITER);
+                // Add Destination Address, Source Address, Ether Type, Length and Delimiter
+                writeHeader(stream.data(), destinationAddress, sourceAddress, payloadLength, frameCheckSequence);
+                hexStreamSize += HEADER_SIZE;
 
-                std::memcpy(buffer_.data() + hexStreamSize, payload.data(), payloadLength);
+                std::memcpy(stream.data() + hexStreamSize, payload.data(), payloadLength);
                 hexStreamSize += payloadLength;
 
-                hexStreamSize = hexStreamSize;
-                return buffer_.data();
+                // Add Frame Check Sequence over the header and payload
+                if (frameCheckSequence) {
+                    writeFrameCheckSequence(stream.data() + hexStreamSize, computeFrameCheckSequence(0, stream.data(), hexStreamSize));
+                    hexStreamSize += FCS_SIZE;
+                }
+
+                finalStreamSize = hexStreamSize;
+                return stream.data();
+            }
+
+            /**
+             * @brief function to convert frame to hex stream (serialize) in per thread scratch
+             * storage. The stream is valid until the next call on the same thread
+             * 
+             * @param[in] finalStreamSize - size_t&: pointer to size variable
+             * 
+             * @return uint8_t *: pointer to start of hex stream
+             */
+            const uint8_t *toHexStream(std::size_t& finalStreamSize) const{
+                thread_local std::array<uint8_t, MAX_FRAME_SIZE> scratch;
+                return toHexStream(scratch, finalStreamSize);
+            }
+
+            /**
+             * @brief function to convert frame to a header, payload and trailer segment (gather serialize).
+             * The payload segment points at the frame payload so it is not copied
+             * 
+             * @param[out] header - array<uint8_t, HEADER_SIZE>&: storage for the serialized header
+             * @param[out] trailer - array<uint8_t, FCS_SIZE>&: storage for the frame check sequence
+             * 
+             * @return array<FrameSegment, 3>: header, payload and (possibly empty) FCS trailer segments
+             */
+            std::array<FrameSegment, 3> toSegments(std::array<uint8_t, HEADER_SIZE>& header,
+                                                   std::array<uint8_t, FCS_SIZE>& trailer) const{
+                writeHeader(header.data(), destinationAddress, sourceAddress, payloadLength, frameCheckSequence);
+                if (!frameCheckSequence) {
+                    return {{ {header.data(), HEADER_SIZE}, {payload.data(), payloadLength}, {trailer.data(), 0} }};
+                }
+
+                uint32_t crc = computeFrameCheckSequence(0, header.data(), HEADER_SIZE);
+                writeFrameCheckSequence(trailer.data(), computeFrameCheckSequence(crc, payload.data(), payloadLength));
+                return {{ {header.data(), HEADER_SIZE}, {payload.data(), payloadLength}, {trailer.data(), FCS_SIZE} }};
+            }
+
+            /**
+             * @brief function to frame an external payload without copying it. Only the
+             * header is written, into caller provided storage
+             * 
+             * @param[out] header - array<uint8_t, HEADER_SIZE>&: storage for the serialized header
+             * @param[in] dest - array<uint8_t, 4>
+             * @param[in] source - array<uint8_t, 4>
+             * @param[in] data - uint8_t *: payload to reference
+             * @param[in] length - uint16_t
+             * 
+             * @return array<FrameSegment, 2>: header segment followed by payload segment
+             */
+            static std::array<FrameSegment, 2> toSegments(std::array<uint8_t, HEADER_SIZE>& header,
+                                                          const std::array<uint8_t, 4>& dest,
+                                                          const std::array<uint8_t, 4>& source,
+                                                          const uint8_t *data, std::uint16_t length){
+                writeHeader(header.data(), dest, source, length);
+                return {{ {header.data(), HEADER_SIZE}, {data, length} }};
+            }
+
+            /**
+             * @brief function to frame an external payload with an FCS trailer without copying it.
+             * Only the header and trailer are written, into caller provided storage
+             * 
+             * @param[out] header - array<uint8_t, HEADER_SIZE>&: storage for the serialized header
+             * @param[out] trailer - array<uint8_t, FCS_SIZE>&: storage for the frame check sequence
+             * @param[in] dest - array<uint8_t, 4>
+             * @param[in] source - array<uint8_t, 4>
+             * @param[in] data - uint8_t *: payload to reference
+             * @param[in] length - uint16_t
+             * 
+             * @return array<FrameSegment, 3>: header, payload and trailer segments
+             */
+            static std::array<FrameSegment, 3> toSegments(std::array<uint8_t, HEADER_SIZE>& header,
+                                                          std::array<uint8_t, FCS_SIZE>& trailer,
+                                                          const std::array<uint8_t, 4>& dest,
+                                                          const std::array<uint8_t, 4>& source,
+                                                          const uint8_t *data, std::uint16_t length){
+                writeHeader(header.data(), dest, source, length, true);
+
+                uint32_t crc = computeFrameCheckSequence(0, header.data(), HEADER_SIZE);
+                writeFrameCheckSequence(trailer.data(), computeFrameCheckSequence(crc, data, length));
+                return {{ {header.data(), HEADER_SIZE}, {data, length}, {trailer.data(), FCS_SIZE} }};
             }
 
             /**
@@ -132,41 +257,44 @@ namespace EthernetDriverSimulation
                     }
 
                     // Assume the Destination and Source Address are in the correct place 
-                    std::memcpy(destinationAddress.data(), buffer, 4);
-                    std::memcpy(sourceAddress.data(), buffer + 4, 4);
+                    std::memcpy(destinationAddress.data(), buffer + FrameHeaderSchema::DESTINATION_ADDRESS_FIELD.offset, 4);
+                    std::memcpy(sourceAddress.data(), buffer + FrameHeaderSchema::SOURCE_ADDRESS_FIELD.offset, 4);
 
-                    // Retrieve EtherType and ensure it matches the expected value
-                    uint16_t etherType = (buffer[8] << 8) | buffer[9];
-                    if (etherType != EDS_ETHERTYPE) {
-                        return ErrorCode::INVALID_ETHER_TYPE;
-                    }
-                    
-                    // Retrieve length and ensure its no greater than max
-                    uint16_t len = (buffer[10] << 8) | buffer[11];
-                    if (len > MAX_PAYLOAD_SIZE) {
-                        return ErrorCode::MALFORMED_FRAME;;
+                    // Validate EtherType, length and delimiter against the schema
+                    ErrorCode headerStatus = FrameHeaderSchema::validate<MAX_PAYLOAD_SIZE>(buffer, MAX_FRAME_SIZE);
+                    if (headerStatus != ErrorCode::SUCCESS) {
+                        return headerStatus;
                     }
+                    uint16_t len = FrameHeaderSchema::decode<FrameHeaderSchema::PAYLOAD_LENGTH_FIELD>(buffer);
+                    uint16_t delimiter = FrameHeaderSchema::decode<FrameHeaderSchema::DELIMITER_FIELD>(buffer);
 
-                    // Retrieve delimiter and ensure it matches the expected value
-                    uint16_t delimiter = (buffer[12] << 8) | buffer[13];
-                    if (delimiter != DELIMITER) {
-                        return ErrorCode::MALFORMED_FRAME;;
+                    // Verify the trailer when the frame carries one
+                    frameCheckSequence = (delimiter == FCS_DELIMITER);
+                    if (frameCheckSequence && !verifyFrameCheckSequence(buffer, HEADER_SIZE + len)) {
+                        return ErrorCode::FCS_MISMATCH;
                     }
                     
                     // Set the payload Length
                     payloadLength = len;
-                    std::memcpy(payload.data(), buffer + 14, payloadLength);
+                    std::memcpy(payload.data(), buffer + HEADER_SIZE, payloadLength);
 
                     // If there was no errors when building the packet; return success
                     return ErrorCode::SUCCESS;
             }
+
+            /**
+             * @brief Helper function to write the frame header to the hex stream
+             */
+            static void writeHeader(uint8_t *buf, const std::array<uint8_t, 4>& dest,
+                                    const std::array<uint8_t, 4>& source, uint16_t length,
+                                    bool frameCheckSequence = false) {
+                FrameHeaderSchema::writeHeader(buf, dest, source, length, frameCheckSequence);
+            }
             /**
              * @}
              */
 
         private:
-            mutable std::array<uint8_t, MAX_FRAME_SIZE> buffer_;
-
             /**
              * @brief Helper function to display a 16 bit int as hex value
              */
@@ -194,16 +322,22 @@ namespace EthernetDriverSimulation
                             addr[0], addr[1], addr[2], addr[3]);
                 return std::string(buffer);
             }
-
-            /**
-             * @brief Helper function to write 16 bit values to the hex stream
-             */
-            static void writeUint16(std::array<uint8_t, MAX_FRAME_SIZE>& buf, std::size_t& hexStreamSize, uint16_t value) {
-                // Shift the bits right to put the first byte in the buffer
-                buf[hexStreamSize++] = static_cast<uint8_t>((value >> 8) & 0xFF);
-                buf[hexStreamSize++] = static_cast<uint8_t>(value & 0xFF);
-            }
     };
+
+    // Frame size selected at build time (see FRAME_SIZE in the Makefile)
+#if defined(EDS_JUMBO_FRAMES)
+    using FrameSizePolicy = JumboFrameSize;
+#elif defined(EDS_STANDARD_MTU_FRAMES)
+    using FrameSizePolicy = StandardMtuFrameSize;
+#else
+    using FrameSizePolicy = DefaultFrameSize;
+#endif
+
+    using EthernetFrame = BasicEthernetFrame<FrameSizePolicy>;
+
+    static_assert(EthernetFrame::MAX_PAYLOAD_SIZE <= 0xFFFF, "Payload length must fit the 16 bit length field");
+    static_assert(EthernetFrame::BUFFER_SIZE >= EthernetFrame::MAX_FRAME_SIZE, "Buffers must hold at least one frame");
+    static_assert(sizeof(EthernetFrame) <= EthernetFrame::MAX_PAYLOAD_SIZE + 16, "Frames hold only their fields; serialize into caller storage");
 };
 
 #endif // EDS_ETHERNET_FRAME_HPP__
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 // Project Includes
 #include "ethernet_frame.hpp"
+#include "frame_view.hpp"
 
 // Declare namespace
 namespace EthernetDriverSimulation
@@ -33,8 +34,12 @@ namespace EthernetDriverSimulation
         UNKNOWN_PACKET = 0xFFFFF,
     };
 
+    // Control frames carry the low 3 bytes of their ExpectedPayloadData value
+    inline constexpr std::size_t CONTROL_PAYLOAD_SIZE = 3;
+
     std::string packetDataToTypeString(ExpectedPayloadData type);
     ExpectedPayloadData findFrameType(EthernetFrame& frame);
+    ExpectedPayloadData findFrameType(const FrameView& frame);
 };
 
 #endif // EDS_ETHERNET_PROTOCOL_HPP__
\ No newline at end of file
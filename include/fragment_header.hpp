@@ -0,0 +1,91 @@
+/**
+ * @file fragment_header.hpp
+ *
+ * @brief Declaration of the header that prefixes every fragment of a stream payload
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAGMENT_HEADER_HPP__
+#define EDS_FRAGMENT_HEADER_HPP__
+
+// Standard Includes
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+// Project Includes
+#include "error_code.hpp"
+#include "ethernet_frame.hpp"
+#include "frame_header_schema.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    struct FragmentHeader {
+        /**
+         * @defgroup Fragment header field layout (start of the frame payload)
+         * @{
+         */
+        static constexpr HeaderField STREAM_ID_FIELD       = {0, 2};
+        static constexpr HeaderField SEQUENCE_NUMBER_FIELD = {STREAM_ID_FIELD.offset + STREAM_ID_FIELD.width, 4};
+        static constexpr HeaderField FRAGMENT_OFFSET_FIELD = {SEQUENCE_NUMBER_FIELD.offset + SEQUENCE_NUMBER_FIELD.width, 4};
+        static constexpr HeaderField FLAGS_FIELD           = {FRAGMENT_OFFSET_FIELD.offset + FRAGMENT_OFFSET_FIELD.width, 2};
+        static constexpr std::size_t SIZE                  = FLAGS_FIELD.offset + FLAGS_FIELD.width;
+        /**
+         * @}
+         */
+
+        static constexpr std::uint16_t LAST_FRAGMENT_FLAG = 0x0001;
+        static constexpr std::size_t   MAX_DATA_SIZE      = EthernetFrame::MAX_PAYLOAD_SIZE - SIZE; // Stream bytes carried per frame
+
+        std::uint16_t streamId = 0;
+        std::uint32_t sequenceNumber = 0;
+        std::uint32_t fragmentOffset = 0; // Byte offset of the fragment data in the stream
+        bool lastFragment = false;
+
+        /**
+         * @brief Whether stream id a was started after stream id b. Ids wrap, so
+         * the nearer direction around the 16 bit space decides
+         */
+        static constexpr bool isLaterStream(std::uint16_t a, std::uint16_t b) {
+            return static_cast<std::int16_t>(static_cast<std::uint16_t>(a - b)) > 0;
+        }
+
+        /**
+         * @brief Write the fragment header to the start of a frame payload
+         *
+         * @param[out] payload - uint8_t *: at least SIZE writable bytes
+         */
+        void write(uint8_t *payload) const {
+            FrameHeaderSchema::encode<STREAM_ID_FIELD>(payload, streamId);
+            FrameHeaderSchema::encode<SEQUENCE_NUMBER_FIELD>(payload, sequenceNumber);
+            FrameHeaderSchema::encode<FRAGMENT_OFFSET_FIELD>(payload, fragmentOffset);
+            FrameHeaderSchema::encode<FLAGS_FIELD>(payload, lastFragment ? LAST_FRAGMENT_FLAG : 0);
+        }
+
+        /**
+         * @brief Read the fragment header from the start of a frame payload
+         *
+         * @param[in] payload - span<const uint8_t>: frame payload
+         *
+         * @return ErrorCode: MALFORMED_FRAME when the payload cannot hold a header
+         */
+        ErrorCode parse(std::span<const uint8_t> payload) {
+            if (payload.size() < SIZE) {
+                return ErrorCode::MALFORMED_FRAME;
+            }
+
+            streamId = FrameHeaderSchema::decode<STREAM_ID_FIELD>(payload.data());
+            sequenceNumber = FrameHeaderSchema::decode<SEQUENCE_NUMBER_FIELD>(payload.data());
+            fragmentOffset = FrameHeaderSchema::decode<FRAGMENT_OFFSET_FIELD>(payload.data());
+            lastFragment = (FrameHeaderSchema::decode<FLAGS_FIELD>(payload.data()) & LAST_FRAGMENT_FLAG) != 0;
+            return ErrorCode::SUCCESS;
+        }
+    };
+
+    static_assert(FragmentHeader::SIZE < EthernetFrame::MAX_PAYLOAD_SIZE, "Fragments must carry stream data");
+};
+
+#endif // EDS_FRAGMENT_HEADER_HPP__
@@ -0,0 +1,66 @@
+/**
+ * @file frame_check_sequence.hpp
+ *
+ * @brief Declaration of the frame check sequence (CRC-32C) used by the optional frame trailer
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_CHECK_SEQUENCE_HPP__
+#define EDS_FRAME_CHECK_SEQUENCE_HPP__
+
+// Standard Includes
+#include <cstddef>
+#include <cstdint>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Structure to hold the running frame check sequence counters
+    struct FrameCheckStatistics {
+        uint64_t framesChecked;
+        uint64_t fcsErrors;
+    };
+
+    /**
+     * @brief Compute (or continue) a CRC-32C over a block of bytes. Uses the SSE4.2
+     * crc32 instruction when the CPU supports it and slice-by-8 tables otherwise.
+     * Chaining calls over consecutive blocks gives the CRC of the whole range
+     *
+     * @param[in] crc - uint32_t: CRC of the preceding bytes (0 to start)
+     * @param[in] data - uint8_t *: bytes to include
+     * @param[in] length - size_t: number of bytes
+     *
+     * @return uint32_t: CRC of the preceding bytes followed by data
+     */
+    uint32_t computeFrameCheckSequence(uint32_t crc, const uint8_t *data, std::size_t length);
+
+    /**
+     * @brief computeFrameCheckSequence on the slice-by-8 tables whatever the CPU,
+     * as it runs without SSE4.2
+     */
+    uint32_t computeFrameCheckSequencePortable(uint32_t crc, const uint8_t *data, std::size_t length);
+
+    /**
+     * @brief Write a frame check sequence to a 4 byte trailer (big endian like
+     * the rest of the header fields)
+     */
+    void writeFrameCheckSequence(uint8_t *trailer, uint32_t crc);
+
+    /**
+     * @brief Verify the trailer that follows the covered bytes of a frame and
+     * update the frame check statistics
+     *
+     * @param[in] frame - uint8_t *: pointer to frame start
+     * @param[in] coveredLength - size_t: header plus payload length; the trailer follows
+     *
+     * @return bool: true when the trailer matches the frame contents
+     */
+    bool verifyFrameCheckSequence(const uint8_t *frame, std::size_t coveredLength);
+
+    FrameCheckStatistics getFrameCheckStatistics();
+    void resetFrameCheckStatistics();
+};
+
+#endif // EDS_FRAME_CHECK_SEQUENCE_HPP__
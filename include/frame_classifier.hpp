@@ -0,0 +1,40 @@
+/**
+ * @file frame_classifier.hpp
+ *
+ * @brief Declaration of the batch frame header validator and classifier
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_CLASSIFIER_HPP__
+#define EDS_FRAME_CLASSIFIER_HPP__
+
+// Standard Includes
+#include <cstdint>
+#include <span>
+
+// Project Includes
+#include "error_code.hpp"
+#include "ethernet_frame.hpp"
+#include "ethernet_protocol.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Validate and classify a batch of serialized frames in place. Produces
+     * the same results as FrameView::parse followed by findFrameType for every
+     * frame, FCS trailers included. Frames that fail validation are classified
+     * as UNKNOWN_PACKET
+     *
+     * @param[in] frames - span<const FrameSegment>: start and readable size of each frame
+     * @param[out] statuses - span<ErrorCode>: validation status of each frame
+     * @param[out] types - span<ExpectedPayloadData>: payload type of each frame
+     */
+    void classifyFrames(std::span<const FrameSegment> frames,
+                        std::span<ErrorCode> statuses,
+                        std::span<ExpectedPayloadData> types);
+};
+
+#endif // EDS_FRAME_CLASSIFIER_HPP__
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * @file frame_header_schema.hpp
+ *
+ * @brief Declaration of the frame header layout and the codecs generated from it
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_HEADER_SCHEMA_HPP__
+#define EDS_FRAME_HEADER_SCHEMA_HPP__
+
+// Standard Includes
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Project Includes
+#include "error_code.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Structure to describe one big endian field of the serialized frame header
+    struct HeaderField {
+        std::size_t offset;
+        std::size_t width;
+    };
+
+    class FrameHeaderSchema {
+        public:
+            /**
+             * @defgroup Header field layout
+             * @{
+             */
+            static constexpr HeaderField DESTINATION_ADDRESS_FIELD = {0, 4};
+            static constexpr HeaderField SOURCE_ADDRESS_FIELD      = {DESTINATION_ADDRESS_FIELD.offset + DESTINATION_ADDRESS_FIELD.width, 4};
+            static constexpr HeaderField ETHER_TYPE_FIELD          = {SOURCE_ADDRESS_FIELD.offset + SOURCE_ADDRESS_FIELD.width, 2};
+            static constexpr HeaderField PAYLOAD_LENGTH_FIELD      = {ETHER_TYPE_FIELD.offset + ETHER_TYPE_FIELD.width, 2};
+            static constexpr HeaderField DELIMITER_FIELD           = {PAYLOAD_LENGTH_FIELD.offset + PAYLOAD_LENGTH_FIELD.width, 2};
+            static constexpr std::size_t HEADER_SIZE               = DELIMITER_FIELD.offset + DELIMITER_FIELD.width;
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Header field values
+             * @{
+             */
+            static constexpr std::uint16_t EDS_ETHERTYPE = 0xC0AF;
+            static constexpr std::uint16_t DELIMITER     = 0xABAB;
+            static constexpr std::uint16_t FCS_DELIMITER = 0xABFC; // Delimiter of frames carrying an FCS trailer
+            static constexpr std::size_t   FCS_SIZE      = 4;
+            /**
+             * @}
+             */
+
+            // Smallest unsigned integer able to hold a field
+            template <HeaderField Field>
+            using FieldType = std::conditional_t<Field.width == 1, uint8_t,
+                              std::conditional_t<Field.width == 2, uint16_t, uint32_t>>;
+
+            /**
+             * @brief Write a field to a serialized header. Unrolled at compile time
+             * into one store per byte
+             *
+             * @param[out] header - uint8_t *: pointer to header start
+             * @param[in] value - FieldType<Field>: value to write
+             */
+            template <HeaderField Field>
+            static constexpr void encode(uint8_t *header, FieldType<Field> value) {
+                static_assert(Field.width >= 1 && Field.width <= 4, "Header fields are 1 to 4 bytes wide");
+
+                [&]<std::size_t... Byte>(std::index_sequence<Byte...>) {
+                    ((header[Field.offset + Byte] = static_cast<uint8_t>(value >> (8 * (Field.width - 1 - Byte)))), ...);
+                }(std::make_index_sequence<Field.width>{});
+            }
+
+            /**
+             * @brief Read a field from a serialized header. Unrolled at compile time
+             * into one load per byte
+             *
+             * @param[in] header - uint8_t *: pointer to header start
+             *
+             * @return FieldType<Field>: value of the field
+             */
+            template <HeaderField Field>
+            static constexpr FieldType<Field> decode(const uint8_t *header) {
+                static_assert(Field.width >= 1 && Field.width <= 4, "Header fields are 1 to 4 bytes wide");
+
+                return [&]<std::size_t... Byte>(std::index_sequence<Byte...>) {
+                    return static_cast<FieldType<Field>>(
+                        ((static_cast<uint32_t>(header[Field.offset + Byte]) << (8 * (Field.width - 1 - Byte))) | ...));
+                }(std::make_index_sequence<Field.width>{});
+            }
+
+            /**
+             * @brief Convert an address to its wire bytes
+             *
+             * @param[in] address - uint32_t
+             *
+             * @return array<uint8_t, 4>: address as written to the address fields
+             */
+            static constexpr std::array<uint8_t, 4> addressToBytes(uint32_t address) {
+                std::array<uint8_t, DESTINATION_ADDRESS_FIELD.width> bytes{};
+                encode<HeaderField{0, DESTINATION_ADDRESS_FIELD.width}>(bytes.data(), address);
+                return bytes;
+            }
+
+            /**
+             * @brief Convert address wire bytes back to an address (the inverse of addressToBytes)
+             *
+             * @param[in] bytes - array<uint8_t, 4>: address as written to the address fields
+             *
+             * @return uint32_t: address
+             */
+            static constexpr uint32_t bytesToAddress(const std::array<uint8_t, 4>& bytes) {
+                return decode<HeaderField{0, DESTINATION_ADDRESS_FIELD.width}>(bytes.data());
+            }
+
+            /**
+             * @brief Write a complete header
+             *
+             * @param[out] header - uint8_t *: pointer to header start
+             * @param[in] dest - array<uint8_t, 4>: destination address wire bytes
+             * @param[in] source - array<uint8_t, 4>: source address wire bytes
+             * @param[in] length - uint16_t: payload length
+             * @param[in] frameCheckSequence - bool: the frame carries an FCS trailer
+             */
+            static constexpr void writeHeader(uint8_t *header, const std::array<uint8_t, 4>& dest,
+                                              const std::array<uint8_t, 4>& source, uint16_t length,
+                                              bool frameCheckSequence) {
+                for (std::size_t i = 0; i < DESTINATION_ADDRESS_FIELD.width; ++i) {
+                    header[DESTINATION_ADDRESS_FIELD.offset + i] = dest[i];
+                    header[SOURCE_ADDRESS_FIELD.offset + i] = source[i];
+                }
+
+                encode<ETHER_TYPE_FIELD>(header, EDS_ETHERTYPE);
+                encode<PAYLOAD_LENGTH_FIELD>(header, length);
+                encode<DELIMITER_FIELD>(header, frameCheckSequence ? FCS_DELIMITER : DELIMITER);
+            }
+
+            /**
+             * @brief Validate a serialized header. Every check is evaluated without
+             * branching and combined in the priority order EtherType, then length
+             * and delimiter. FCS trailer contents are not checked here
+             *
+             * @param[in] header - uint8_t *: pointer to frame start
+             * @param[in] size - size_t: number of readable bytes at header
+             *
+             * @return ErrorCode: status of the validation process
+             */
+            template <std::size_t MaxPayloadSize>
+            static ErrorCode validate(const uint8_t *header, std::size_t size) {
+                // If the buffer is NULL or cannot hold a header than return error
+                if (!header || size < HEADER_SIZE) {
+                    return ErrorCode::MALFORMED_FRAME;
+                }
+
+                uint16_t delimiter = decode<DELIMITER_FIELD>(header);
+                std::size_t length = decode<PAYLOAD_LENGTH_FIELD>(header);
+                bool hasTrailer = (delimiter == FCS_DELIMITER);
+
+                bool etherTypeOk = (decode<ETHER_TYPE_FIELD>(header) == EDS_ETHERTYPE);
+                bool frameOk = (length <= MaxPayloadSize) &
+                               (HEADER_SIZE + length + hasTrailer * FCS_SIZE <= size) &
+                               ((delimiter == DELIMITER) | hasTrailer);
+
+                ErrorCode frameStatus = frameOk ? ErrorCode::SUCCESS : ErrorCode::MALFORMED_FRAME;
+                return etherTypeOk ? frameStatus : ErrorCode::INVALID_ETHER_TYPE;
+            }
+    };
+
+    static_assert(FrameHeaderSchema::bytesToAddress(FrameHeaderSchema::addressToBytes(0x01020304)) == 0x01020304,
+                  "bytesToAddress must invert addressToBytes");
+};
+
+#endif // EDS_FRAME_HEADER_SCHEMA_HPP__
\ No newline at end of file
@@ -0,0 +1,200 @@
+/**
+ * @file frame_queue.hpp
+ *
+ * @brief Declaration of the bounded lock-free multi producer / single consumer queue of frame slots
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_QUEUE_HPP__
+#define EDS_FRAME_QUEUE_HPP__
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Project Includes
+#include "frame_ring.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Bounded queue of preallocated frame slots (Vyukov style). Each slot
+     * carries a sequence number that says whose turn it is: equal to a position
+     * it is free for the producer that claims that position, one past it the
+     * frame is published for the consumer. Any number of producer threads claim
+     * positions with a single compare and swap on the enqueue index, then fill
+     * their slots without further coordination; one consumer thread drains the
+     * slots in order
+     */
+    template <std::size_t SlotSize, std::size_t Capacity>
+    class FrameQueue {
+        public:
+            // One frame; padded so neighbouring slots never share a cache line
+            struct alignas(CACHE_LINE_SIZE) FrameSlot {
+                std::atomic<std::size_t> sequence;
+                std::size_t length;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                uint64_t storedAt;          // LatencyClock time the producer filled the slot
+#endif
+                std::array<uint8_t, SlotSize> data;
+            };
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            FrameQueue() {
+                for (std::size_t i = 0; i < Capacity; ++i) {
+                    slots[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            FrameQueue(const FrameQueue&) = delete;
+            FrameQueue& operator=(const FrameQueue&) = delete;
+
+            static constexpr std::size_t capacity() { return Capacity; }
+
+            /**
+             * @brief Producer side: claim up to count consecutive free slots
+             *
+             * @param[in] count - size_t: slots wanted
+             * @param[out] position - size_t&: position of the first claimed slot
+             *
+             * @return size_t: slots claimed, 0 when the queue is full
+             */
+            std::size_t claim(std::size_t count, std::size_t& position) {
+                std::size_t enqueuePosition = enqueue_.value.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    // Count the free slots from the current enqueue position
+                    std::size_t freeCount = 0;
+                    while (freeCount < count && freeCount < Capacity &&
+                           slotAt(enqueuePosition + freeCount).sequence.load(std::memory_order_acquire) == enqueuePosition + freeCount) {
+                        freeCount++;
+                    }
+
+                    if (freeCount == 0) {
+                        // The consumer has not released the slot yet: the queue is full
+                        std::size_t sequence = slotAt(enqueuePosition).sequence.load(std::memory_order_acquire);
+                        if (static_cast<std::ptrdiff_t>(sequence - enqueuePosition) < 0) {
+                            return 0;
+                        }
+
+                        // Another producer claimed the position first
+                        enqueuePosition = enqueue_.value.load(std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    if (enqueue_.value.compare_exchange_weak(enqueuePosition, enqueuePosition + freeCount, std::memory_order_relaxed)) {
+                        position = enqueuePosition;
+                        return freeCount;
+                    }
+                }
+            }
+
+            /**
+             * @brief Producer side: whether the next position is still held by the consumer
+             */
+            bool full() const {
+                std::size_t enqueuePosition = enqueue_.value.load(std::memory_order_relaxed);
+                std::size_t sequence = slots[enqueuePosition % Capacity].sequence.load(std::memory_order_acquire);
+                return static_cast<std::ptrdiff_t>(sequence - enqueuePosition) < 0;
+            }
+
+            /**
+             * @brief Slot at a queue position
+             */
+            FrameSlot& slotAt(std::size_t position) {
+                return slots[position % Capacity];
+            }
+
+            /**
+             * @brief Producer side: hand claimed and filled slots to the consumer
+             */
+            void publish(std::size_t position, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    slotAt(position + i).sequence.store(position + i + 1, std::memory_order_release);
+                }
+            }
+
+            /**
+             * @brief Consumer side: next published slot in queue order
+             *
+             * @return FrameSlot *: slot, NULL when the next frame is not published yet
+             */
+            const FrameSlot *front() {
+                return peek(0);
+            }
+
+            /**
+             * @brief Consumer side: published slot index places behind the front, the front not yet popped
+             *
+             * @return FrameSlot *: slot, NULL when that frame is not published yet
+             */
+            const FrameSlot *peek(std::size_t index) {
+                if (index >= Capacity) {
+                    return nullptr;
+                }
+
+                FrameSlot& slot = slotAt(dequeue_.value + index);
+                if (slot.sequence.load(std::memory_order_acquire) != dequeue_.value + index + 1) {
+                    return nullptr;
+                }
+                return &slot;
+            }
+
+            /**
+             * @brief Consumer side: number of frames published in order from the front, counted up to limit
+             */
+            std::size_t readable(std::size_t limit) {
+                std::size_t count = 0;
+                while (count < limit && count < Capacity &&
+                       slotAt(dequeue_.value + count).sequence.load(std::memory_order_acquire) == dequeue_.value + count + 1) {
+                    count++;
+                }
+                return count;
+            }
+
+            /**
+             * @brief Consumer side: release the count front slots for the producers' next lap
+             */
+            void pop(std::size_t count = 1) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    slotAt(dequeue_.value).sequence.store(dequeue_.value + Capacity, std::memory_order_release);
+                    dequeue_.value++;
+                }
+            }
+            /**
+             * @}
+             */
+
+        private:
+            // Enqueue index on its own cache line; only producers touch it
+            struct alignas(CACHE_LINE_SIZE) PaddedAtomicIndex {
+                std::atomic<std::size_t> value{0};
+            };
+
+            // Dequeue index on its own cache line; only the consumer touches it
+            struct alignas(CACHE_LINE_SIZE) PaddedIndex {
+                std::size_t value = 0;
+            };
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            std::array<FrameSlot, Capacity> slots;
+            PaddedAtomicIndex enqueue_;
+            PaddedIndex dequeue_;
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // EDS_FRAME_QUEUE_HPP__
@@ -0,0 +1,132 @@
+/**
+ * @file frame_ring.hpp
+ *
+ * @brief Declaration of the lock-free single producer / single consumer ring of frame slots
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_RING_HPP__
+#define EDS_FRAME_RING_HPP__
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Size of the cache line the ring pads its slots and indices to
+    inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief Fixed capacity ring of preallocated frame slots shared by one
+     * producer thread and one consumer thread without locks. The producer fills
+     * slots after the tail and publishes them with a release store; the consumer
+     * reads slots after the head and hands them back the same way. Each side
+     * keeps a cached copy of the other side's index so the shared cache lines
+     * are only read when the ring looks full (or empty)
+     */
+    template <std::size_t SlotSize, std::size_t Capacity>
+    class FrameRing {
+        public:
+            // One frame; padded so neighbouring slots never share a cache line
+            struct alignas(CACHE_LINE_SIZE) FrameSlot {
+                std::size_t length;
+                std::array<uint8_t, SlotSize> data;
+            };
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            FrameRing() = default;
+            FrameRing(const FrameRing&) = delete;
+            FrameRing& operator=(const FrameRing&) = delete;
+
+            static constexpr std::size_t capacity() { return Capacity; }
+
+            /**
+             * @brief Producer side: number of slots that can be filled before publishing
+             */
+            std::size_t writableSlots() {
+                std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+
+                // Only look at the consumer's index when the cached one says the ring is full
+                if (tail - cachedHead == Capacity) {
+                    cachedHead = head_.value.load(std::memory_order_acquire);
+                }
+                return Capacity - (tail - cachedHead);
+            }
+
+            /**
+             * @brief Producer side: slot index slots after the tail (index < writableSlots())
+             */
+            FrameSlot& producerSlot(std::size_t index) {
+                return slots[(tail_.value.load(std::memory_order_relaxed) + index) % Capacity];
+            }
+
+            /**
+             * @brief Producer side: make the next count filled slots visible to the consumer
+             */
+            void publish(std::size_t count) {
+                tail_.value.store(tail_.value.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            }
+
+            /**
+             * @brief Consumer side: number of published slots waiting to be read
+             */
+            std::size_t readableSlots() {
+                std::size_t head = head_.value.load(std::memory_order_relaxed);
+
+                // Only look at the producer's index when the cached one says the ring is empty
+                if (cachedTail == head) {
+                    cachedTail = tail_.value.load(std::memory_order_acquire);
+                }
+                return cachedTail - head;
+            }
+
+            /**
+             * @brief Consumer side: slot index slots after the head (index < readableSlots())
+             */
+            const FrameSlot& consumerSlot(std::size_t index) const {
+                return slots[(head_.value.load(std::memory_order_relaxed) + index) % Capacity];
+            }
+
+            /**
+             * @brief Consumer side: hand the next count read slots back to the producer
+             */
+            void release(std::size_t count) {
+                head_.value.store(head_.value.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            }
+            /**
+             * @}
+             */
+
+        private:
+            // Index on its own cache line so producer and consumer updates do not false share
+            struct alignas(CACHE_LINE_SIZE) PaddedIndex {
+                std::atomic<std::size_t> value{0};
+            };
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            std::array<FrameSlot, Capacity> slots;
+
+            PaddedIndex head_;                       // Next slot to read; written by the consumer
+            alignas(CACHE_LINE_SIZE) std::size_t cachedTail = 0; // Consumer's copy of tail_
+
+            PaddedIndex tail_;                       // Next slot to fill; written by the producer
+            alignas(CACHE_LINE_SIZE) std::size_t cachedHead = 0; // Producer's copy of head_
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // EDS_FRAME_RING_HPP__
@@ -0,0 +1,72 @@
+/**
+ * @file frame_transport.hpp
+ *
+ * @brief Declaration of the interface of a transport that carries frames between two drivers
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_TRANSPORT_HPP__
+#define EDS_FRAME_TRANSPORT_HPP__
+
+// Standard Includes
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// Project Includes
+#include "packet_receiver.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Structure to hold the counters of a transport
+    struct TransportStatistics {
+        uint64_t framesSent = 0;
+        uint64_t framesReceived = 0;
+        uint64_t framesDropped = 0;       // Refused by the local driver as malformed, or lost by the transport
+        uint64_t systemCalls = 0;         // Every system call made to move frames or wake the peer
+    };
+
+    /**
+     * @brief Transport linking the local driver to a peer driver, usually in
+     * another process. It registers as the local driver's receiver of the
+     * peer's address: frames the driver forwards to that address are sent to
+     * the peer, and the peer's frames are stored into the local driver by
+     * poll, which forwards them to the local receivers as usual. The driver
+     * sees a transport as any other credit limited receiver
+     */
+    class FrameTransport : public PacketReceiver {
+        public:
+
+            /**
+             * @defgroup Public virtual function declarations
+             * @{
+             */
+            virtual ~FrameTransport() = default;
+
+            /**
+             * @brief Store up to budget frames received from the peer into the local
+             * driver, and return the credit for frames the peer has taken
+             *
+             * @return size_t: frames stored
+             */
+            virtual std::size_t poll(std::size_t budget) = 0;
+
+            /**
+             * @brief Sleep until poll has work or the timeout passed
+             *
+             * @return bool: true when poll has work
+             */
+            virtual bool wait(std::chrono::nanoseconds timeout) = 0;
+
+            virtual TransportStatistics getStatistics() const = 0;
+            virtual void close() = 0;
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // EDS_FRAME_TRANSPORT_HPP__
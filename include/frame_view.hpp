@@ -0,0 +1,127 @@
+/**
+ * @file frame_view.hpp
+ *
+ * @brief Declaration of a non-owning view used to parse ethernet frames in place
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_FRAME_VIEW_HPP__
+#define EDS_FRAME_VIEW_HPP__
+
+// Standard Includes
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+
+// Project Includes
+#include "error_code.hpp"
+#include "ethernet_frame.hpp"
+#include "frame_header_schema.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    class FrameView {
+        public:
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            FrameView() = default;
+
+            /**
+             * @brief Point the view at a frame that was already validated (e.g. by
+             * classifyFrames) without checking it again
+             *
+             * @param[in] validatedBuffer - uint8_t *: pointer to frame start
+             */
+            explicit FrameView(const uint8_t* validatedBuffer) : data_(validatedBuffer) {}
+
+            /**
+             * @brief Validate a serialized frame and point the view at it. No frame
+             * bytes are copied; the view is only valid while the buffer is alive
+             *
+             * @param[in] buffer - uint8_t *: pointer to frame start
+             * @param[in] size - size_t: number of readable bytes at buffer
+             *
+             * @return ErrorCode: status of the validation process
+             */
+            ErrorCode parse(const uint8_t* buffer, std::size_t size) {
+                // Drop any previously parsed frame
+                data_ = nullptr;
+
+                // Validate the header fields against the schema
+                ErrorCode headerStatus = FrameHeaderSchema::validate<EthernetFrame::MAX_PAYLOAD_SIZE>(buffer, size);
+                if (headerStatus != ErrorCode::SUCCESS) {
+                    return headerStatus;
+                }
+
+                uint16_t len = FrameHeaderSchema::decode<FrameHeaderSchema::PAYLOAD_LENGTH_FIELD>(buffer);
+                bool frameCheckSequence = (FrameHeaderSchema::decode<FrameHeaderSchema::DELIMITER_FIELD>(buffer) == EthernetFrame::FCS_DELIMITER);
+
+                // Verify the trailer when the frame carries one
+                if (frameCheckSequence && !verifyFrameCheckSequence(buffer, EthernetFrame::HEADER_SIZE + len)) {
+                    return ErrorCode::FCS_MISMATCH;
+                }
+
+                data_ = buffer;
+                return ErrorCode::SUCCESS;
+            }
+
+            /**
+             * @brief Accessors for the header fields of the viewed frame
+             */
+            std::span<const uint8_t, 4> destinationAddress() const {
+                return std::span<const uint8_t, 4>(data_ + FrameHeaderSchema::DESTINATION_ADDRESS_FIELD.offset, 4);
+            }
+            std::span<const uint8_t, 4> sourceAddress() const {
+                return std::span<const uint8_t, 4>(data_ + FrameHeaderSchema::SOURCE_ADDRESS_FIELD.offset, 4);
+            }
+            uint32_t destination() const { return FrameHeaderSchema::decode<FrameHeaderSchema::DESTINATION_ADDRESS_FIELD>(data_); }
+            uint32_t source() const { return FrameHeaderSchema::decode<FrameHeaderSchema::SOURCE_ADDRESS_FIELD>(data_); }
+            uint16_t etherType() const { return FrameHeaderSchema::decode<FrameHeaderSchema::ETHER_TYPE_FIELD>(data_); }
+            uint16_t payloadLength() const { return FrameHeaderSchema::decode<FrameHeaderSchema::PAYLOAD_LENGTH_FIELD>(data_); }
+            uint16_t delimiter() const { return FrameHeaderSchema::decode<FrameHeaderSchema::DELIMITER_FIELD>(data_); }
+            bool hasFrameCheckSequence() const { return delimiter() == EthernetFrame::FCS_DELIMITER; }
+
+            /**
+             * @brief Access the payload of the viewed frame without copying it
+             *
+             * @return span<const uint8_t>: payload bytes inside the wire buffer
+             */
+            std::span<const uint8_t> payload() const {
+                return std::span<const uint8_t>(data_ + EthernetFrame::HEADER_SIZE, payloadLength());
+            }
+
+            /**
+             * @brief Generate a string to display the frame header
+             *
+             * @return string representing the frame
+             */
+            std::string frameHeaderToString() const {
+                char buffer[256];
+                std::snprintf(buffer, sizeof(buffer),
+                    "Ethernet Packet:\n\tDestination Address: 0x%08X"
+                    "\n\tSource Address: 0x%08X"
+                    "\n\tEtherType: 0x%04X"
+                    "\n\tDelimiter: 0x%04X"
+                    "\n\tPayload Length: 0x%04X"
+                    "\n\tPayload Data Start: 0x%02X...",
+                    destination(), source(),
+                    etherType(), delimiter(), payloadLength(),
+                    payloadLength() > 0 ? data_[EthernetFrame::HEADER_SIZE] : 0);
+                return std::string(buffer);
+            }
+            /**
+             * @}
+             */
+
+        private:
+            const uint8_t* data_ = nullptr;
+    };
+};
+
+#endif // EDS_FRAME_VIEW_HPP__
\ No newline at end of file
@@ -12,6 +12,12 @@
 
 // Standard Imports
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 #include <cstdint>
 
@@ -21,6 +27,7 @@
 #include "ethernet_frame.hpp"
 #include "packet_receiver.hpp"
 #include "ethernet_protocol.hpp"
+#include "stream_reassembler.hpp"
 
 namespace EthernetDriverSimulation{
     class Host : public PacketReceiver {
@@ -30,7 +37,7 @@ namespace EthernetDriverSimulation{
              * @defgroup Public constant declarations
              * @{
              */
-            static constexpr size_t RX_BUFFER_SIZE = 8192;
+            static constexpr size_t RX_BUFFER_SIZE = EthernetFrame::BUFFER_SIZE;
             static constexpr size_t MAX_PACKETS = RX_BUFFER_SIZE / EthernetFrame::MAX_FRAME_SIZE;
             /**
              * @}
@@ -51,9 +58,13 @@ namespace EthernetDriverSimulation{
             ~Host() = default;
 
             void clearRxBuffer();
+            bool waitForReceivedFrames(std::chrono::milliseconds timeout);
             void receiveFrame(const uint8_t *data, size_t size) override;
-            void sendFrame(const std::vector<uint8_t>& payload);
+            void receiveFrames(std::span<const FrameRef> frames) override;
+            ErrorCode sendFrame(const std::vector<uint8_t>& payload);
+            ErrorCode sendFrames(std::span<const std::span<const uint8_t>> payloads);
             void setDestinationAddress(uint32_t address);
+            void setFrameCheckSequence(bool enabled);
             void performHandshake( void );
             void requestVideo( void );
             void injectFrameError( InjectionType injectionType );
@@ -79,6 +90,21 @@ namespace EthernetDriverSimulation{
              * @}
              */
         private:
+            // Structure to locate a received frame inside the rx slab
+            struct ReceivedFrame {
+                std::size_t offset;
+                std::size_t length;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                uint64_t forwardedAt = 0;   // LatencyClock time the driver handed the frame over
+#endif
+            };
+
+            // Structure to hold a batch of received frames and the slab backing their bytes
+            struct RxBuffer {
+                std::unique_ptr<uint8_t[]> slab;          // RX_BUFFER_SIZE bytes, filled up to slabUsed
+                std::size_t slabUsed = 0;
+                std::vector<ReceivedFrame> frames;
+            };
 
             /**
              * @defgroup Private constant definitions
@@ -96,8 +122,21 @@ namespace EthernetDriverSimulation{
              */
             EthernetDriver* driver;
             uint32_t address;
-            std::vector<std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE>> rxBuffer;
+            std::mutex rxLock;                            // Guards rxFilling, which the driver's worker may fill
+            std::condition_variable rxSignal;             // Raised when frames land in rxFilling
+            RxBuffer rxFilling;                           // Filled by receiveFrames
+            RxBuffer rxProcessing;                        // Owned by processReceivedFrames
+            std::vector<FrameSegment> rxFrames;
+            std::vector<ErrorCode> rxFrameStatuses;
+            std::vector<ExpectedPayloadData> rxFrameTypes;
             uint32_t destinationAddress;
+            bool frameCheckSequenceEnabled = true;
+            std::ofstream encodedVideoFile;
+            StreamReassembler videoReassembler;
+            bool videoStreamActive = false;     // A stream is being written to encodedVideoFile
+            uint16_t videoStreamId = 0;         // Stream being written while videoStreamActive
+            bool videoStreamFinished = false;   // finishedVideoStreamId is valid
+            uint16_t finishedVideoStreamId = 0; // Latest stream decoded or given up; its fragments and older are dropped
             /**
              * @}
              */
@@ -106,7 +145,10 @@ namespace EthernetDriverSimulation{
              * @defgroup Private Function declarations
              * @{
              */
-            const std::vector<uint8_t> convertEnumToBytes(ExpectedPayloadData data);
+            void sendControlFrame(ExpectedPayloadData data);
+            void releaseRxBuffer();
+            void acceptVideoFragment(const FragmentHeader& fragment, std::span<const uint8_t> data);
+            void finishVideoStream();
             /**
              * @}
              */
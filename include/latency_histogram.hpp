@@ -0,0 +1,147 @@
+/**
+ * @file latency_histogram.hpp
+ *
+ * @brief Declaration of the log bucketed latency histograms and the clock their samples come from
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_LATENCY_HISTOGRAM_HPP__
+#define EDS_LATENCY_HISTOGRAM_HPP__
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Clock of the latency samples, in nanoseconds. The monotonic clock
+     * is read through the vDSO on Linux, so a sample costs no system call; the
+     * coarse clocks tick once per scheduler jiffy, far too slowly for stages
+     * that take microseconds
+     */
+    struct LatencyClock {
+        static uint64_t now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    };
+
+    /**
+     * @brief Layout of the latency buckets (HDR style). Values below
+     * 2^SIGNIFICANT_BITS nanoseconds get a bucket each; above that every power
+     * of two is split into 2^(SIGNIFICANT_BITS - 1) equal buckets, so a
+     * bucket is never wider than about 6% of the values it holds. Values past
+     * the last power of two land in the last bucket
+     */
+    struct LatencyBuckets {
+        static constexpr unsigned int SIGNIFICANT_BITS = 5;
+        static constexpr unsigned int MAX_EXPONENT = 40;            // Up to about 18 minutes
+        static constexpr std::size_t LINEAR_COUNT = std::size_t{1} << SIGNIFICANT_BITS;
+        static constexpr std::size_t SUB_BUCKET_COUNT = LINEAR_COUNT / 2;
+        static constexpr std::size_t COUNT = LINEAR_COUNT + (MAX_EXPONENT - SIGNIFICANT_BITS + 1) * SUB_BUCKET_COUNT;
+
+        static std::size_t indexOf(uint64_t nanoseconds) {
+            if (nanoseconds < LINEAR_COUNT) {
+                return static_cast<std::size_t>(nanoseconds);
+            }
+
+            unsigned int exponent = static_cast<unsigned int>(std::bit_width(nanoseconds)) - 1;
+            if (exponent > MAX_EXPONENT) {
+                return COUNT - 1;
+            }
+
+            std::size_t subBucket = static_cast<std::size_t>(nanoseconds >> (exponent - SIGNIFICANT_BITS + 1)) & (SUB_BUCKET_COUNT - 1);
+            return LINEAR_COUNT + (exponent - SIGNIFICANT_BITS) * SUB_BUCKET_COUNT + subBucket;
+        }
+
+        // Largest value that falls in a bucket
+        static uint64_t highestValueOf(std::size_t index) {
+            if (index < LINEAR_COUNT) {
+                return index;
+            }
+
+            unsigned int exponent = static_cast<unsigned int>((index - LINEAR_COUNT) / SUB_BUCKET_COUNT) + SIGNIFICANT_BITS;
+            uint64_t subBucket = (index - LINEAR_COUNT) % SUB_BUCKET_COUNT;
+            unsigned int width = exponent - SIGNIFICANT_BITS + 1;
+            return ((SUB_BUCKET_COUNT + subBucket + 1) << width) - 1;
+        }
+    };
+
+    // Structure to hold the samples of one stage, merged over the threads and queues that recorded them
+    struct LatencyDistribution {
+        std::array<uint64_t, LatencyBuckets::COUNT> counts = {};
+        uint64_t samples = 0;
+        uint64_t maximum = 0;
+
+        /**
+         * @brief Latency below which the given fraction of the samples fall (0.5, 0.99, 0.999, ...)
+         *
+         * @return uint64_t: nanoseconds, rounded up to the top of the sample's bucket; 0 without samples
+         */
+        uint64_t percentile(double fraction) const {
+            if (samples == 0) {
+                return 0;
+            }
+
+            // Rank of the sample, counted from 1
+            uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(samples) + 0.5);
+            rank = (rank == 0) ? 1 : (rank > samples ? samples : rank);
+
+            uint64_t seen = 0;
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    uint64_t value = LatencyBuckets::highestValueOf(i);
+                    return value < maximum ? value : maximum;
+                }
+            }
+            return maximum;
+        }
+    };
+
+    /**
+     * @brief Latency histogram with a single writer thread. Recording a sample
+     * is one relaxed load and store, like the driver's other counters; any
+     * thread may add the histogram into a distribution at any time
+     */
+    class LatencyHistogram {
+        public:
+            void record(uint64_t nanoseconds) {
+                std::atomic<uint64_t>& bucket = buckets[LatencyBuckets::indexOf(nanoseconds)];
+                bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                if (nanoseconds > maximum.load(std::memory_order_relaxed)) {
+                    maximum.store(nanoseconds, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief Add the samples recorded so far into a distribution
+             */
+            void collect(LatencyDistribution& distribution) const {
+                for (std::size_t i = 0; i < LatencyBuckets::COUNT; ++i) {
+                    uint64_t count = buckets[i].load(std::memory_order_relaxed);
+                    distribution.counts[i] += count;
+                    distribution.samples += count;
+                }
+
+                uint64_t largest = maximum.load(std::memory_order_relaxed);
+                if (largest > distribution.maximum) {
+                    distribution.maximum = largest;
+                }
+            }
+
+        private:
+            std::array<std::atomic<uint64_t>, LatencyBuckets::COUNT> buckets = {};
+            std::atomic<uint64_t> maximum{0};
+    };
+};
+
+#endif // EDS_LATENCY_HISTOGRAM_HPP__
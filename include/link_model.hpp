@@ -0,0 +1,232 @@
+/**
+ * @file link_model.hpp
+ *
+ * @brief Declaration of the emulated link between the driver and a receiver, and of the delay line holding frames in flight
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_LINK_MODEL_HPP__
+#define EDS_LINK_MODEL_HPP__
+
+// Standard Includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Enumeration to hold the distribution the per frame jitter is drawn from
+    enum class JitterDistribution : uint8_t {
+        NONE = 0,       // Every frame takes exactly the propagation delay
+        UNIFORM,        // Uniform within +/- jitter
+        NORMAL,         // Normal with jitter as the standard deviation
+    };
+
+    // Structure to hold the configuration of an emulated link
+    struct LinkParameters {
+        uint64_t bitRate = 0;                                 // Bits per second; 0 serializes instantly
+        std::chrono::nanoseconds propagationDelay{0};
+        std::chrono::nanoseconds jitter{0};
+        JitterDistribution jitterDistribution = JitterDistribution::NONE;
+        std::size_t overheadBytes = 20;                       // Preamble and interframe gap sent with every frame
+    };
+
+    // Structure to hold what an emulated link delivered, against what it was configured for
+    struct LinkStatistics {
+        uint64_t configuredBitRate = 0;
+        uint64_t framesDelivered = 0;
+        uint64_t payloadBytesDelivered = 0;
+        uint64_t wireBytesDelivered = 0;                      // Frames plus their per frame overhead
+        std::chrono::nanoseconds elapsed{0};                  // First frame on the wire until the last arrived
+        double goodputBitsPerSecond = 0.0;                    // Payload bits over the elapsed time
+        double goodputRatio = 0.0;                            // Goodput over the configured bit rate
+    };
+
+    /**
+     * @brief Emulated full speed link towards one receiver: frames are
+     * serialized one after the other at the bit rate, then arrive after the
+     * propagation delay plus jitter. Jitter never reorders the frames of a
+     * link, as on a real wire. Several queue consumers may send over one link
+     * at the same time
+     */
+    class LinkModel {
+        public:
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            explicit LinkModel(const LinkParameters& parameters);
+
+            /**
+             * @brief Put a frame on the wire
+             *
+             * @param[in] frameSize - size_t: bytes of the frame
+             * @param[in] now - uint64_t: LatencyClock time the frame is ready to send
+             * @param[in] random - minstd_rand&: the calling consumer's jitter source
+             *
+             * @return uint64_t: LatencyClock time the frame arrives at the receiver
+             */
+            uint64_t schedule(std::size_t frameSize, uint64_t now, std::minstd_rand& random);
+
+            /**
+             * @brief Count a frame handed to the receiver on arrival
+             */
+            void countDelivered(std::size_t frameSize, std::size_t payloadSize, uint64_t arrival);
+
+            LinkStatistics getStatistics() const;
+            const LinkParameters& getParameters() const { return parameters; }
+            /**
+             * @}
+             */
+
+        private:
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            LinkParameters parameters;
+            std::atomic<uint64_t> wireFreeAt{0};            // The previous frame has left the sender by then
+            std::atomic<uint64_t> lastArrival{0};
+            std::atomic<uint64_t> firstDeparture{0};        // 0 until the first frame
+            std::atomic<uint64_t> lastDelivered{0};
+            std::atomic<uint64_t> framesDelivered{0};
+            std::atomic<uint64_t> payloadBytesDelivered{0};
+            std::atomic<uint64_t> wireBytesDelivered{0};
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Private function declarations
+             * @{
+             */
+            uint64_t serializationTime(std::size_t frameSize) const;
+            int64_t drawJitter(std::minstd_rand& random) const;
+            /**
+             * @}
+             */
+    };
+
+    /**
+     * @brief Frames in flight on the emulated links of one queue, released in
+     * arrival order. Frames are copied out of the queue when they go on the
+     * wire, so the queue keeps accepting frames while they travel. A binary
+     * heap of (arrival, sequence) keys orders them; the sequence keeps frames
+     * with the same arrival time in sending order. The storage is allocated
+     * once by reserve; one consumer thread uses the line, any thread may ask
+     * whether it is empty
+     */
+    template <std::size_t SlotSize>
+    class DelayLine {
+        public:
+            // Structure to hold one frame in flight
+            struct Frame {
+                uint64_t arrival = 0;
+                uint32_t address = 0;            // Receiver it is travelling to
+                std::size_t length = 0;
+                std::array<uint8_t, SlotSize> data;
+            };
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            void reserve(std::size_t capacity) {
+                if (capacity <= frames.size()) {
+                    return;
+                }
+
+                std::size_t previousCapacity = frames.size();
+                frames.resize(capacity);
+                heap.reserve(capacity);
+                freeList.reserve(capacity);
+                for (std::size_t i = capacity; i-- > previousCapacity;) {
+                    freeList.push_back(i);
+                }
+            }
+
+            bool full() const { return freeList.empty(); }
+            bool empty() const { return count.load(std::memory_order_acquire) == 0; }
+            uint64_t nextArrival() const { return frames[heap.front().index].arrival; }
+
+            /**
+             * @brief Copy a frame onto the line; the line must not be full
+             */
+            void push(uint64_t arrival, uint32_t address, const uint8_t* data, std::size_t length) {
+                std::size_t index = freeList.back();
+                freeList.pop_back();
+
+                Frame& frame = frames[index];
+                frame.arrival = arrival;
+                frame.address = address;
+                frame.length = length;
+                std::memcpy(frame.data.data(), data, length);
+
+                heap.push_back({arrival, nextSequence++, index});
+                std::push_heap(heap.begin(), heap.end(), later);
+                count.store(heap.size(), std::memory_order_release);
+            }
+
+            /**
+             * @brief Frame that arrives first, if it has arrived by now
+             *
+             * @return const Frame *: frame, NULL when none is due
+             */
+            const Frame *due(uint64_t now) const {
+                if (heap.empty() || heap.front().arrival > now) {
+                    return nullptr;
+                }
+                return &frames[heap.front().index];
+            }
+
+            /**
+             * @brief Release the frame returned by due
+             */
+            void pop() {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                freeList.push_back(heap.back().index);
+                heap.pop_back();
+                count.store(heap.size(), std::memory_order_release);
+            }
+            /**
+             * @}
+             */
+
+        private:
+            // Heap key of a frame in flight
+            struct Key {
+                uint64_t arrival;
+                uint64_t sequence;
+                std::size_t index;
+            };
+
+            // Orders the heap so that its front arrives first
+            static bool later(const Key& first, const Key& second) {
+                return first.arrival != second.arrival ? first.arrival > second.arrival : first.sequence > second.sequence;
+            }
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            std::vector<Frame> frames;
+            std::vector<Key> heap;
+            std::vector<std::size_t> freeList;
+            uint64_t nextSequence = 0;
+            std::atomic<std::size_t> count{0};
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // EDS_LINK_MODEL_HPP__
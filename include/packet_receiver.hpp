@@ -12,9 +12,16 @@
 // Standard Includes
 #include <cstdint>
 #include <cstddef>
+#include <span>
 
 namespace EthernetDriverSimulation {
 
+    // Structure to hold a frame handed to a receiver; valid only for the duration of the call
+    struct FrameRef {
+        const uint8_t* data;
+        size_t size;
+    };
+
     class PacketReceiver {
     public:
 
@@ -24,6 +31,19 @@ namespace EthernetDriverSimulation {
          */
         virtual ~PacketReceiver() = default;
         virtual void receiveFrame(const uint8_t* data, size_t size) = 0;
+
+        /**
+         * @brief Frames the driver forwarded to the receiver in a row, in order. The
+         * driver uses this when draining a queue; receivers that keep frames
+         * should take the whole batch in one go instead of frame by frame
+         *
+         * @param[in] frames - span<const FrameRef>: frames, each one credit
+         */
+        virtual void receiveFrames(std::span<const FrameRef> frames) {
+            for (const FrameRef& frame : frames) {
+                receiveFrame(frame.data, frame.size);
+            }
+        }
         /**
          * @}
          */
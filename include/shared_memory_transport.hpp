@@ -0,0 +1,156 @@
+/**
+ * @file shared_memory_transport.hpp
+ *
+ * @brief Declaration of the transport that carries frames between two processes through shared memory
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_SHARED_MEMORY_TRANSPORT_HPP__
+#define EDS_SHARED_MEMORY_TRANSPORT_HPP__
+
+// Standard Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <string>
+
+// Project Includes
+#include "driver_statistics.hpp"
+#include "error_code.hpp"
+#include "ethernet_driver.hpp"
+#include "ethernet_frame.hpp"
+#include "frame_ring.hpp"
+#include "frame_transport.hpp"
+
+#if defined(__linux__)
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Transport between two processes over a named POSIX shared memory
+     * region (shm_open, so processes started apart can meet by name) holding
+     * one lock-free frame ring per direction. Moving a frame is a copy into
+     * the ring and a release store: no system call. A side only sleeps on a
+     * futex in the shared region when it has nothing to do, and is only woken
+     * (one futex wake) when the peer sees it sleeping, so a busy link makes
+     * no system calls at all. One side creates the region, the other attaches
+     * to it; both must be built with the same frame size. The peer's address
+     * is registered with as many credits as the ring holds frames, and credit
+     * comes back as the peer drains the ring, so the ring never overflows.
+     * Frames whose source is the peer (broadcasts fanned out back to it) are
+     * not sent back. poll and wait are called by one thread. Linux only
+     */
+    class SharedMemoryTransport : public FrameTransport {
+        public:
+            // Enumeration to hold which side of the region a transport is
+            enum class Role : uint8_t {
+                CREATE = 0,       // Creates (and on close removes) the region
+                ATTACH = 1,       // Attaches to a region the peer created
+            };
+
+            /**
+             * @defgroup Public constant declarations
+             * @{
+             */
+            static constexpr std::size_t RING_FRAMES = 64;      // Per direction
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            explicit SharedMemoryTransport(EthernetDriver* driver);
+            ~SharedMemoryTransport() override;
+
+            SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+            SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+            /**
+             * @brief Create or attach to the shared region and register the peer's address with the driver
+             *
+             * @param[in] name - string: name of the region, shared by both sides
+             * @param[in] role - Role: CREATE on one side, ATTACH on the other
+             * @param[in] remoteAddress - uint32_t: address of the peer's receiver
+             *
+             * @return ErrorCode: TRANSPORT_NOT_READY while the creator is not done (retry), TRANSPORT_MISMATCH for a peer with another frame size
+             */
+            ErrorCode open(const std::string& name, Role role, uint32_t remoteAddress);
+
+            void receiveFrame(const uint8_t* data, std::size_t size) override;
+            void receiveFrames(std::span<const FrameRef> frames) override;
+            std::size_t poll(std::size_t budget) override;
+            bool wait(std::chrono::nanoseconds timeout) override;
+            TransportStatistics getStatistics() const override;
+            void close() override;
+            /**
+             * @}
+             */
+
+        private:
+            using Ring = FrameRing<EthernetFrame::MAX_FRAME_SIZE, RING_FRAMES>;
+
+            // Futex word of one side: bumped to wake it, with a flag telling the peer it may sleep
+            struct alignas(CACHE_LINE_SIZE) Endpoint {
+                std::atomic<uint32_t> doorbell{0};
+                std::atomic<uint32_t> sleeping{0};
+            };
+
+            // Layout of the shared region; rings[i] carries the frames sent by side i
+            struct SharedRegion {
+                uint64_t magic = 0;
+                uint64_t regionSize = 0;
+                int64_t creator = 0;                  // Process id, to tell a region left behind by a dead creator
+                std::atomic<uint32_t> ready{0};
+                Endpoint endpoints[2];
+                Ring rings[2];
+            };
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            EthernetDriver* driver;
+            SharedRegion* region = nullptr;
+            int descriptor = -1;
+            std::string regionName;
+            Role role = Role::CREATE;
+            uint32_t remoteAddress = 0;
+            Ring* outgoing = nullptr;
+            Ring* incoming = nullptr;
+            Endpoint* local = nullptr;
+            Endpoint* remote = nullptr;
+            std::mutex sendLock;                      // Driver queues serviced by several workers take turns
+            std::size_t framesAccepted = 0;           // Frames the driver handed over, sent or not; under sendLock
+            std::size_t creditedUpTo = 0;             // Credit given to the driver in total; under sendLock
+            StatisticsCounter framesSent;
+            StatisticsCounter framesReceived;
+            StatisticsCounter framesDropped;
+            std::atomic<uint64_t> systemCalls{0};
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Private function declarations
+             * @{
+             */
+            void wake(Endpoint& endpoint);
+            std::size_t returnCredit();
+            bool hasWork();
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // __linux__
+
+#endif // EDS_SHARED_MEMORY_TRANSPORT_HPP__
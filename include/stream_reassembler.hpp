@@ -0,0 +1,125 @@
+/**
+ * @file stream_reassembler.hpp
+ *
+ * @brief Declaration of the engine that rebuilds a fragmented stream in order
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_STREAM_REASSEMBLER_HPP__
+#define EDS_STREAM_REASSEMBLER_HPP__
+
+// Standard Includes
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+// Project Includes
+#include "error_code.hpp"
+#include "fragment_header.hpp"
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    // Structure to hold the running reassembly counters
+    struct ReassemblyStatistics {
+        uint64_t fragmentsDelivered;
+        uint64_t fragmentsReordered;   // Held in the window until the fragments before them arrived
+        uint64_t duplicateFragments;
+        uint64_t missingFragments;     // Skipped because the window moved past them
+    };
+
+    class StreamReassembler {
+        public:
+            /**
+             * @defgroup Public constant declarations
+             * @{
+             */
+            static constexpr std::size_t REORDER_WINDOW = 32; // Fragments held while waiting for a gap to fill
+            /**
+             * @}
+             */
+
+            // Receives the stream bytes in order
+            using DeliverCallback = std::function<void(std::span<const uint8_t>)>;
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            explicit StreamReassembler(DeliverCallback deliver);
+            ~StreamReassembler() = default;
+
+            /**
+             * @brief Accept one fragment. In order fragments are delivered straight
+             * away; later ones are held in a fixed window until the fragments
+             * before them arrive. A fragment that does not fit the window means
+             * the oldest missing fragments are not coming: they are skipped and
+             * counted so only REORDER_WINDOW fragments are ever buffered. A
+             * fragment of a different stream restarts reassembly
+             *
+             * @param[in] header - FragmentHeader: parsed fragment header
+             * @param[in] data - span<const uint8_t>: stream bytes of the fragment
+             *
+             * @return ErrorCode: FRAGMENT_GAP when stream bytes had to be skipped
+             */
+            ErrorCode acceptFragment(const FragmentHeader& header, std::span<const uint8_t> data);
+
+            /**
+             * @brief Deliver every held fragment, skipping the missing ones, and end
+             * the stream. Used when no more fragments of the stream will arrive
+             *
+             * @return ErrorCode: FRAGMENT_GAP when stream bytes had to be skipped
+             */
+            ErrorCode flush();
+
+            void reset();
+            bool isComplete() const { return complete; }
+            const ReassemblyStatistics& getStatistics() const { return statistics; }
+            /**
+             * @}
+             */
+
+        private:
+            // Structure to hold a fragment that arrived ahead of the stream
+            struct HeldFragment {
+                bool occupied = false;
+                bool lastFragment = false;
+                uint32_t sequenceNumber = 0;
+                uint32_t fragmentOffset = 0;
+                std::vector<uint8_t> data;
+            };
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            DeliverCallback deliver;
+            std::array<HeldFragment, REORDER_WINDOW> window;
+            ReassemblyStatistics statistics = {};
+            bool active = false;
+            bool complete = false;
+            uint16_t streamId = 0;
+            uint32_t nextSequence = 0;
+            uint64_t nextOffset = 0;
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Private function declarations
+             * @{
+             */
+            ErrorCode deliverFragment(uint32_t fragmentOffset, std::span<const uint8_t> data, bool lastFragment);
+            ErrorCode advanceTo(uint32_t sequenceNumber);
+            ErrorCode drainWindow();
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // EDS_STREAM_REASSEMBLER_HPP__
@@ -0,0 +1,359 @@
+/**
+ * @file timing_wheel.hpp
+ *
+ * @brief Declaration of the hierarchical timing wheel that keeps the driver's and the protocol's timers
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_TIMING_WHEEL_HPP__
+#define EDS_TIMING_WHEEL_HPP__
+
+// Standard Includes
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Hierarchical timing wheel (Varghese and Lauck). Time is counted in
+     * ticks of a fixed resolution; eight levels of 256 slots cover every 64
+     * bit tick, level L holding the timers whose expiry first differs from the
+     * current tick in its L-th byte. Scheduling, cancelling and rescheduling
+     * a timer each link or unlink one node of a slot's list: O(1), whatever
+     * the number of timers. As time advances the wheel jumps straight to the
+     * next occupied slot (found in per level occupancy bitmaps) and cascades
+     * its timers one level down, so idle stretches cost nothing. Timers live
+     * in one growing array and are reused, so a busy wheel stops allocating.
+     * Not thread safe; callbacks are handed out by expire for the caller to
+     * run, so they may schedule timers again
+     */
+    class TimingWheel {
+        public:
+            using TimerId = uint64_t;
+            using Callback = std::function<void()>;
+
+            /**
+             * @defgroup Public constant declarations
+             * @{
+             */
+            static constexpr TimerId INVALID_TIMER = 0;
+            static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+
+            /**
+             * @param[in] resolution - uint64_t: nanoseconds per tick
+             * @param[in] now - uint64_t: current time in nanoseconds
+             */
+            TimingWheel(uint64_t resolution, uint64_t now)
+                : resolution(resolution == 0 ? 1 : resolution),
+                  current(now / this->resolution)
+            {
+                heads.fill(NONE);
+            }
+
+            std::size_t size() const { return count; }
+
+            /**
+             * @brief Add a timer; it never fires before its expiry
+             *
+             * @param[in] expiry - uint64_t: time in nanoseconds
+             * @param[in] callback - Callback: handed out by expire once due
+             *
+             * @return TimerId: id to cancel or reschedule the timer with
+             */
+            TimerId schedule(uint64_t expiry, Callback callback) {
+
+                // Initialize method variables
+                uint32_t index = 0;
+
+                if (freeList.empty()) {
+                    index = static_cast<uint32_t>(timers.size());
+                    timers.emplace_back();
+                }
+                else {
+                    index = freeList.back();
+                    freeList.pop_back();
+                }
+
+                Timer& timer = timers[index];
+                timer.callback = std::move(callback);
+                timer.expiry = toTick(expiry);
+                link(index);
+                count++;
+
+                return idOf(index);
+            }
+
+            /**
+             * @brief Move a pending timer to a new expiry
+             *
+             * @return bool: false when the timer already fired or was cancelled
+             */
+            bool reschedule(TimerId id, uint64_t expiry) {
+                uint32_t index = 0;
+                if (!find(id, index)) {
+                    return false;
+                }
+
+                unlink(index);
+                timers[index].expiry = toTick(expiry);
+                link(index);
+                return true;
+            }
+
+            /**
+             * @brief Remove a pending timer without running it
+             *
+             * @return bool: false when the timer already fired or was cancelled
+             */
+            bool cancel(TimerId id) {
+                uint32_t index = 0;
+                if (!find(id, index)) {
+                    return false;
+                }
+
+                unlink(index);
+                release(index);
+                return true;
+            }
+
+            /**
+             * @brief Advance to a time and take the next timer due by then. Call it
+             * until it returns false to fire every due timer
+             *
+             * @param[in] now - uint64_t: current time in nanoseconds
+             * @param[out] callback - Callback&: callback of the due timer
+             *
+             * @return bool: true when a timer was due
+             */
+            bool expire(uint64_t now, Callback& callback) {
+
+                // Initialize method variables
+                uint64_t target = now / resolution;
+
+                for (;;) {
+                    // Timers of the current tick wait in its level 0 slot
+                    uint32_t index = heads[slotOf(0, digitOf(current, 0))];
+                    if (index != NONE) {
+                        unlink(index);
+                        callback = std::move(timers[index].callback);
+                        release(index);
+                        return true;
+                    }
+
+                    // Jump to the next occupied slot, cascading its timers down on arrival
+                    uint64_t next = nextSlotStart();
+                    if (next > target) {
+                        current = std::max(current, target);
+                        return false;
+                    }
+
+                    current = next;
+                    for (unsigned int level = LEVELS; level-- > 1;) {
+                        cascade(level);
+                    }
+                }
+            }
+
+            /**
+             * @brief Earliest time a timer may be due, for sleeping until then
+             *
+             * @return uint64_t: nanoseconds, never later than the next expiry; NEVER without timers
+             */
+            uint64_t nextExpiry() const {
+                if (count == 0) {
+                    return NEVER;
+                }
+                if (heads[slotOf(0, digitOf(current, 0))] != NONE) {
+                    return current * resolution;
+                }
+
+                uint64_t next = nextSlotStart();
+                return next > NEVER / resolution ? NEVER : next * resolution;
+            }
+            /**
+             * @}
+             */
+
+        private:
+            // One timer; free timers keep their place in the array for reuse
+            struct Timer {
+                uint64_t expiry = 0;               // Tick
+                uint32_t previous = NONE;
+                uint32_t next = NONE;
+                uint32_t slot = NONE;              // Level * SLOTS + slot, NONE when not scheduled
+                uint32_t generation = 0;           // Tells a reused timer from the one an old id named
+                Callback callback;
+            };
+
+            /**
+             * @defgroup Private constant declarations
+             * @{
+             */
+            static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+            static constexpr unsigned int SLOT_BITS = 8;
+            static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+            static constexpr unsigned int LEVELS = 64 / SLOT_BITS;
+            static constexpr std::size_t BITMAP_WORDS = SLOTS / 64;
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            uint64_t resolution;
+            uint64_t current;                                                   // Tick the wheel stands at
+            std::size_t count = 0;
+            std::vector<Timer> timers;
+            std::vector<uint32_t> freeList;
+            std::array<uint32_t, LEVELS * SLOTS> heads;                         // First timer of each slot
+            std::array<std::array<uint64_t, BITMAP_WORDS>, LEVELS> occupied = {};
+            std::array<std::size_t, LEVELS> levelCounts = {};
+            /**
+             * @}
+             */
+
+            static std::size_t slotOf(unsigned int level, std::size_t digit) { return level * SLOTS + digit; }
+            static std::size_t digitOf(uint64_t tick, unsigned int level) { return static_cast<std::size_t>(tick >> (level * SLOT_BITS)) & (SLOTS - 1); }
+
+            // Expiry tick of a time, rounded up so a timer never fires early. Timers already due wait
+            // for the next tick, so a callback that schedules itself again cannot keep expire busy
+            uint64_t toTick(uint64_t time) const {
+                uint64_t tick = time / resolution + (time % resolution != 0 ? 1 : 0);
+                return std::max(tick, current + 1);
+            }
+
+            TimerId idOf(uint32_t index) const {
+                return (static_cast<TimerId>(timers[index].generation) << 32) | (static_cast<TimerId>(index) + 1);
+            }
+
+            bool find(TimerId id, uint32_t& index) const {
+                uint64_t position = id & 0xFFFFFFFFull;
+                if (position == 0 || position > timers.size()) {
+                    return false;
+                }
+
+                index = static_cast<uint32_t>(position - 1);
+                const Timer& timer = timers[index];
+                return timer.slot != NONE && timer.generation == static_cast<uint32_t>(id >> 32);
+            }
+
+            // Put a timer in the slot of the highest byte its expiry differs from the current tick in
+            void link(uint32_t index) {
+                Timer& timer = timers[index];
+                uint64_t difference = timer.expiry ^ current;
+                unsigned int level = difference == 0 ? 0 : static_cast<unsigned int>(std::bit_width(difference) - 1) / SLOT_BITS;
+                std::size_t digit = digitOf(timer.expiry, level);
+                std::size_t slot = slotOf(level, digit);
+
+                timer.slot = static_cast<uint32_t>(slot);
+                timer.previous = NONE;
+                timer.next = heads[slot];
+                if (timer.next != NONE) {
+                    timers[timer.next].previous = index;
+                }
+                heads[slot] = index;
+
+                occupied[level][digit / 64] |= uint64_t{1} << (digit % 64);
+                levelCounts[level]++;
+            }
+
+            void unlink(uint32_t index) {
+                Timer& timer = timers[index];
+                std::size_t slot = timer.slot;
+                unsigned int level = static_cast<unsigned int>(slot / SLOTS);
+                std::size_t digit = slot % SLOTS;
+
+                if (timer.previous != NONE) {
+                    timers[timer.previous].next = timer.next;
+                }
+                else {
+                    heads[slot] = timer.next;
+                }
+                if (timer.next != NONE) {
+                    timers[timer.next].previous = timer.previous;
+                }
+
+                if (heads[slot] == NONE) {
+                    occupied[level][digit / 64] &= ~(uint64_t{1} << (digit % 64));
+                }
+                levelCounts[level]--;
+                timer.slot = NONE;
+            }
+
+            void release(uint32_t index) {
+                Timer& timer = timers[index];
+                timer.callback = nullptr;
+                timer.generation++;
+                freeList.push_back(index);
+                count--;
+            }
+
+            // Re-link the timers of a level's current slot, now that the wheel has reached its span
+            void cascade(unsigned int level) {
+                std::size_t slot = slotOf(level, digitOf(current, level));
+                uint32_t index = heads[slot];
+                while (index != NONE) {
+                    uint32_t next = timers[index].next;
+                    unlink(index);
+                    link(index);
+                    index = next;
+                }
+            }
+
+            // First tick of the earliest occupied slot ahead of the current tick; NEVER when there is none
+            uint64_t nextSlotStart() const {
+
+                // Initialize method variables
+                uint64_t next = NEVER;
+
+                for (unsigned int level = 0; level < LEVELS; ++level) {
+                    if (levelCounts[level] == 0) {
+                        continue;
+                    }
+
+                    // Slots of a level only hold timers ahead of the current digit
+                    std::size_t digit = digitOf(current, level) + 1;
+                    for (std::size_t word = digit / 64; word < BITMAP_WORDS; ++word) {
+                        uint64_t bits = occupied[level][word];
+                        if (word == digit / 64) {
+                            bits &= (digit % 64 == 0) ? ~uint64_t{0} : ~((uint64_t{1} << (digit % 64)) - 1);
+                        }
+                        if (bits == 0) {
+                            continue;
+                        }
+
+                        // Keep the bytes above the level, set the level's byte to the slot and clear the ones below
+                        unsigned int shift = (level + 1) * SLOT_BITS;
+                        uint64_t prefix = shift >= 64 ? 0 : (current >> shift) << shift;
+                        uint64_t slotDigit = word * 64 + static_cast<uint64_t>(std::countr_zero(bits));
+                        next = std::min(next, prefix | (slotDigit << (level * SLOT_BITS)));
+                        break;
+                    }
+                }
+
+                return next;
+            }
+    };
+};
+
+#endif // EDS_TIMING_WHEEL_HPP__
@@ -0,0 +1,150 @@
+/**
+ * @file udp_transport.hpp
+ *
+ * @brief Declaration of the transport that carries frames between two processes over loopback UDP
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_UDP_TRANSPORT_HPP__
+#define EDS_UDP_TRANSPORT_HPP__
+
+// Standard Includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// Project Includes
+#include "driver_statistics.hpp"
+#include "error_code.hpp"
+#include "ethernet_driver.hpp"
+#include "ethernet_frame.hpp"
+#include "frame_transport.hpp"
+
+#if defined(__linux__)
+
+// System Includes
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// Declare namespace
+namespace EthernetDriverSimulation
+{
+    /**
+     * @brief Transport between two processes over a connected UDP socket on
+     * the loopback interface, one frame per datagram. Frames the driver
+     * forwards to the peer are copied into a batch and sent with one sendmmsg
+     * when the batch is full or at the next poll (or flush); poll receives up
+     * to a batch of datagrams with one recvmmsg. System calls are so paid per
+     * batch rather than per frame, and counted in the statistics. The peer's
+     * address is registered with as many credits as the batch holds frames,
+     * and credit comes back as frames leave, so a socket that cannot keep up
+     * holds frames back in the driver's queue instead of dropping them. As
+     * with any UDP, datagrams the peer's socket has no room for are lost.
+     * Frames whose source is the peer are not sent back. poll and wait are
+     * called by one thread. Linux only
+     */
+    class UdpTransport : public FrameTransport {
+        public:
+            /**
+             * @defgroup Public constant declarations
+             * @{
+             */
+            static constexpr std::size_t BATCH_FRAMES = 32;                 // Per sendmmsg and per recvmmsg
+            static constexpr int SOCKET_BUFFER_SIZE = 4 * 1024 * 1024;      // Requested for both directions
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Public function declarations
+             * @{
+             */
+            explicit UdpTransport(EthernetDriver* driver);
+            ~UdpTransport() override;
+
+            UdpTransport(const UdpTransport&) = delete;
+            UdpTransport& operator=(const UdpTransport&) = delete;
+
+            /**
+             * @brief Bind a loopback socket, connect it to the peer's port and register the peer's address with the driver
+             *
+             * @param[in] localPort - uint16_t: port this side receives on
+             * @param[in] remotePort - uint16_t: port the peer receives on
+             * @param[in] remoteAddress - uint32_t: address of the peer's receiver
+             *
+             * @return ErrorCode: TRANSPORT_OPEN_FAILED when the socket cannot be set up
+             */
+            ErrorCode open(uint16_t localPort, uint16_t remotePort, uint32_t remoteAddress);
+
+            /**
+             * @brief Send the frames batched so far
+             *
+             * @return size_t: frames sent
+             */
+            std::size_t flush();
+
+            void receiveFrame(const uint8_t* data, std::size_t size) override;
+            void receiveFrames(std::span<const FrameRef> frames) override;
+            std::size_t poll(std::size_t budget) override;
+            bool wait(std::chrono::nanoseconds timeout) override;
+            TransportStatistics getStatistics() const override;
+            void close() override;
+            /**
+             * @}
+             */
+
+        private:
+            using FrameBuffer = std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE>;
+
+            // Preallocated frames of one direction, with the message headers sendmmsg / recvmmsg take
+            struct Batch {
+                std::vector<FrameBuffer> frames;
+                std::vector<iovec> vectors;
+                std::vector<mmsghdr> messages;
+
+                void allocate();
+            };
+
+            /**
+             * @defgroup Private variable declarations
+             * @{
+             */
+            EthernetDriver* driver;
+            int socketDescriptor = -1;
+            uint32_t remoteAddress = 0;
+            std::mutex sendLock;                  // Driver queues serviced by several workers take turns
+            Batch sendBatch;                      // Under sendLock
+            std::size_t sendCount = 0;            // Frames waiting in sendBatch
+            bool sendBlocked = false;             // The socket had no room for the front of sendBatch; under sendLock
+            Batch receiveBatch;
+            std::size_t receiveNext = 0;          // First datagram of receiveBatch not yet stored
+            std::size_t receiveCount = 0;         // Datagrams received into receiveBatch
+            StatisticsCounter framesSent;         // Under sendLock
+            StatisticsCounter framesReceived;
+            std::atomic<uint64_t> framesDropped{0};
+            std::atomic<uint64_t> systemCalls{0};
+            /**
+             * @}
+             */
+
+            /**
+             * @defgroup Private function declarations
+             * @{
+             */
+            std::size_t sendBatched();
+            /**
+             * @}
+             */
+    };
+};
+
+#endif // __linux__
+
+#endif // EDS_UDP_TRANSPORT_HPP__
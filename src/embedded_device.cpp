@@ -11,13 +11,20 @@
 #include "embedded_device.hpp"
 
 // Standard Incudes
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <utility>
 
 // Project Includes
 #include "ethernet_protocol.hpp"
+#include "fragment_header.hpp"
+#include "frame_classifier.hpp"
+#include "frame_header_schema.hpp"
+#include "frame_view.hpp"
 #include "video_codec.hpp"
 #include "ethernet_driver.hpp"
 
@@ -27,74 +34,235 @@ namespace EthernetDriverSimulation {
         : driver(driver), 
           address(address) 
     {
-        driver->registerReceiver(address, this);
+        // Allocate the rx buffer up front so receiving never allocates
+        for (RxBuffer* buffer : {&rxFilling, &rxProcessing}) {
+            buffer->slab = std::make_unique_for_overwrite<uint8_t[]>(RX_BUFFER_SIZE);
+            buffer->frames.reserve(MAX_PACKETS);
+        }
+        rxFrames.reserve(MAX_PACKETS);
+        rxFrameStatuses.reserve(MAX_PACKETS);
+        rxFrameTypes.reserve(MAX_PACKETS);
+
+        // Grant the driver one credit per frame the rx buffer holds
+        driver->registerReceiver(address, this, MAX_PACKETS);
     }
 
     void EmbeddedDevice::receiveFrame(const uint8_t *data, size_t size) {
-        // Put frame in rx buffer
-        std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE> frame;
-        std::memcpy(frame.data(), data, size);
-        rxBuffer.push_back(frame);
+        FrameRef frame = {data, size};
+        receiveFrames(std::span<const FrameRef>(&frame, 1));
+    }
+
+    void EmbeddedDevice::receiveFrames(std::span<const FrameRef> frames) {
+
+        // Initialize method variables
+        std::size_t framesTaken = 0;
+        std::size_t bytesTaken = 0;
+
+        {
+            // The driver's worker delivers here while the owner may be swapping the buffers
+            std::lock_guard<std::mutex> lock(rxLock);
+            std::size_t slabOffset = rxFilling.slabUsed;
+            std::size_t firstFrame = rxFilling.frames.size();
+
+            // Take the frames the rx buffer has room for
+            while (framesTaken < frames.size() && slabOffset + bytesTaken + frames[framesTaken].size <= RX_BUFFER_SIZE) {
+                bytesTaken += frames[framesTaken].size;
+                framesTaken++;
+            }
+
+            // Grow the frame list once for the batch (within its reserved capacity), then copy in only the bytes on the wire
+            rxFilling.frames.resize(firstFrame + framesTaken);
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            uint64_t forwardedAt = LatencyClock::now();
+#endif
+            for (std::size_t i = 0; i < framesTaken; ++i) {
+                std::memcpy(rxFilling.slab.get() + slabOffset, frames[i].data, frames[i].size);
+                rxFilling.frames[firstFrame + i] = {slabOffset, frames[i].size};
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                rxFilling.frames[firstFrame + i].forwardedAt = forwardedAt;
+#endif
+                slabOffset += frames[i].size;
+            }
+            rxFilling.slabUsed = slabOffset;
+        }
+
+        if (framesTaken > 0) {
+            rxSignal.notify_one();
+        }
+
+        // Drop the frames the rx buffer cannot hold, handing their credit straight back
+        if (framesTaken < frames.size()) {
+            driver->grantCredit(address, frames.size() - framesTaken);
+        }
+    }
+
+    ErrorCode EmbeddedDevice::sendFrame(const std::vector<uint8_t>& payload) {
+
+        // Initialize method variables
+        std::array<uint8_t, 4> dest = FrameHeaderSchema::addressToBytes(destinationAddress);
+        std::array<uint8_t, 4> source = FrameHeaderSchema::addressToBytes(address);
+        std::array<uint8_t, EthernetFrame::HEADER_SIZE> header;
+        std::array<uint8_t, EthernetFrame::FCS_SIZE> trailer;
+
+        // Check before narrowing: a length cast to 16 bits would wrap and frame only a prefix of the payload
+        if (payload.size() > EthernetFrame::MAX_PAYLOAD_SIZE) {
+            return ErrorCode::MALFORMED_FRAME;
+        }
+
+        // Frame the payload in place; only the header (and trailer) is serialized
+        if (frameCheckSequenceEnabled) {
+            return driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                trailer,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
+        else {
+            return driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
     }
 
-    void EmbeddedDevice::sendFrame(const std::vector<uint8_t>& payload) {
+    ErrorCode EmbeddedDevice::sendFrames(std::span<const std::span<const uint8_t>> payloads, EthernetDriver::TxCompletion onComplete) {
 
         // Initialize method variables
-        std::array<uint8_t, 4> dest;
-        std::array<uint8_t, 4> source;
-        const uint8_t *dataPtr;  
+        std::array<uint8_t, 4> dest = FrameHeaderSchema::addressToBytes(destinationAddress);
+        std::array<uint8_t, 4> source = FrameHeaderSchema::addressToBytes(address);
+        std::vector<FramePayload> batch;
 
-        // Convert dest
-        std::memcpy(dest.data(), &destinationAddress, 4);
+        // Describe each payload; the driver stores them in order as its queues drain. A payload too large
+        // for a frame fails the transmission here, before its length is narrowed to 16 bits; it still completes
+        batch.reserve(payloads.size());
+        for (const auto& payload : payloads) {
+            if (payload.size() > EthernetFrame::MAX_PAYLOAD_SIZE) {
+                if (onComplete) {
+                    onComplete(ErrorCode::MALFORMED_FRAME, 0);
+                }
+                return ErrorCode::MALFORMED_FRAME;
+            }
+            batch.push_back({dest, source, payload.data(), static_cast<uint16_t>(payload.size()), frameCheckSequenceEnabled});
+        }
+
+        // The payload bytes must stay put until the completion
+        driver->transmit(batch, std::move(onComplete));
+        return ErrorCode::SUCCESS;
+    }
 
-        // Convert source
-        std::memcpy(source.data(), &address, 4);
+    void EmbeddedDevice::sendControlFrame(ExpectedPayloadData data) {
 
-        // Convert payload
-        dataPtr = payload.data();
+        // Initialize method variables
+        std::array<uint8_t, 4> dest = FrameHeaderSchema::addressToBytes(destinationAddress);
+        std::array<uint8_t, 4> source = FrameHeaderSchema::addressToBytes(address);
+        std::array<uint8_t, EthernetFrame::HEADER_SIZE> header;
+        std::array<uint8_t, EthernetFrame::FCS_SIZE> trailer;
+        std::array<uint8_t, CONTROL_PAYLOAD_SIZE> payload;
+        uint32_t rawData = static_cast<uint32_t>(data);
 
-        // Construct Handshake packet
-        EthernetFrame frame(
-            dest,
-            source,
-            dataPtr,
-            payload.size()
-        ) ;
+        // The control payload lives on the stack; the driver copies the frame before this returns
+        for (std::size_t i = 0; i < CONTROL_PAYLOAD_SIZE; ++i) {
+            payload[i] = static_cast<uint8_t>((rawData >> (8 * i)) & 0xFF);
+        }
 
-        std::size_t size = 0;
-        driver->storeSerializedFrame(frame.toHexStream(size));
+        if (frameCheckSequenceEnabled) {
+            driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                trailer,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
+        else {
+            driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
     }
 
     ErrorCode EmbeddedDevice::processReceivedFrames() {
-        // Loop through all frames in the buffer
+        // Validate and classify every buffered frame header in one batch (scratch is reused between calls)
+        std::vector<FrameSegment>& frames = rxFrames;
+        std::vector<ErrorCode>& frameStatuses = rxFrameStatuses;
+        std::vector<ExpectedPayloadData>& frameTypes = rxFrameTypes;
+
+        // Take every frame received so far; the worker fills the emptied buffer meanwhile
+        {
+            std::lock_guard<std::mutex> lock(rxLock);
+            std::swap(rxFilling, rxProcessing);
+        }
+        const std::vector<ReceivedFrame>& rxBuffer = rxProcessing.frames;
+
+        frames.clear();
+        frameStatuses.resize(rxBuffer.size());
+        frameTypes.resize(rxBuffer.size());
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        uint64_t processedAt = LatencyClock::now();
+#endif
         for (const auto& frame : rxBuffer) {
-            EthernetFrame currentFrame;
+            frames.push_back({rxProcessing.slab.get() + frame.offset, frame.length});
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            driver->recordProcessLatency(processedAt - frame.forwardedAt);
+#endif
+        }
 
-            ErrorCode parseFrameStatus = currentFrame.fromHexSteam(frame.data());
+        classifyFrames(frames, frameStatuses, frameTypes);
+
+        // First failing frame's status; the frames after it are still processed
+        ErrorCode batchStatus = ErrorCode::SUCCESS;
+
+        // Loop through all frames in the buffer
+        for (std::size_t i = 0; i < rxBuffer.size(); ++i) {
+            // View the frame in place inside the rx buffer
+            FrameView currentFrame(frames[i].data);
+
+            ErrorCode parseFrameStatus = frameStatuses[i];
 
             if (ErrorCode::SUCCESS != parseFrameStatus)
             {
                 // Send ERROR back
                 ExpectedPayloadData data = ExpectedPayloadData::ERROR;
-                sendFrame(convertEnumToBytes(data));
+                sendControlFrame(data);
 
-                return parseFrameStatus;
+                if (ErrorCode::SUCCESS == batchStatus) {
+                    batchStatus = parseFrameStatus;
+                }
+                continue;
             }
             else 
             {
-                ExpectedPayloadData packetType = findFrameType(currentFrame);
+                ExpectedPayloadData packetType = frameTypes[i];
                 
                 // Received Packet is Handshake
                 if (ExpectedPayloadData::HANDSHAKE == packetType)
                 {
                     // Send ACKNOWLEDGEMENT back
                     ExpectedPayloadData data = ExpectedPayloadData::HANDSHAKE;
-                    sendFrame(convertEnumToBytes(data));
+                    sendControlFrame(data);
 
                 }
                 // Received VIDEO_REQUEST
                 else if (ExpectedPayloadData::VIDEO_REQUEST == packetType)
                 {
+                    // The previous video is still being sent out of its fragments
+                    if (videoTransmitting.load(std::memory_order_acquire))
+                    {
+                        std::cout << "VIDEO REQUEST IGNORED: previous video transfer still in progress\n";
+                        continue;
+                    }
+
                     // Encode File
                     // Create Decoder Object
                     VideoCodec videoEncoder;
@@ -102,54 +270,89 @@ namespace EthernetDriverSimulation {
                     // Decode Video and save to file
                     videoEncoder.encodeGifToH264(ORIGINAL_VIDEO_FILE_PATH, ENCODED_ON_DEVICE_VIDEO_FILE_PATH);
 
-                    // Open encoded file
+                    // Read the encoded file in one pass
                     std::ifstream encodedFile(ENCODED_ON_DEVICE_VIDEO_FILE_PATH, std::ios::binary);
+                    std::vector<uint8_t> encodedData((std::istreambuf_iterator<char>(encodedFile)), std::istreambuf_iterator<char>());
 
-                    std::vector<uint8_t> buffer(EthernetFrame::MAX_FRAME_SIZE);
-                    
-                    // Loop through 1024 bytes at a type until no more data in file
-                    while (encodedFile.read(reinterpret_cast<char *>(buffer.data()), EthernetFrame::MAX_FRAME_SIZE) || encodedFile.gcount() > 0)
-                    {
-                        size_t bytesRead = encodedFile.gcount();
-
-                        // Shrink buffer to actual size (in case final chunk is < 1024 bytes)
-                        buffer.resize(bytesRead);
+                    // Split the file into fragments that each fit one frame (the final fragment may be shorter)
+                    std::size_t fragmentCount = std::max<std::size_t>(1, (encodedData.size() + FragmentHeader::MAX_DATA_SIZE - 1) / FragmentHeader::MAX_DATA_SIZE);
+                    std::vector<uint8_t>& fragments = videoFragments;
+                    fragments.resize(fragmentCount * FragmentHeader::SIZE + encodedData.size());
+                    std::vector<std::span<const uint8_t>> chunks;
+                    chunks.reserve(fragmentCount);
 
-                        // Now create a reference to the current chunk
-                        const std::vector<uint8_t>& chunkRef = buffer;
+                    uint8_t *fragmentStart = fragments.data();
+                    for (std::size_t sequence = 0; sequence < fragmentCount; ++sequence)
+                    {
+                        std::size_t offset = sequence * FragmentHeader::MAX_DATA_SIZE;
+                        std::size_t chunkSize = std::min(FragmentHeader::MAX_DATA_SIZE, encodedData.size() - offset);
 
-                        // Send Packets
-                        sendFrame(chunkRef);
+                        FragmentHeader fragment;
+                        fragment.streamId = videoStreamId;
+                        fragment.sequenceNumber = static_cast<uint32_t>(sequence);
+                        fragment.fragmentOffset = static_cast<uint32_t>(offset);
+                        fragment.lastFragment = (sequence + 1 == fragmentCount);
+                        fragment.write(fragmentStart);
+                        std::memcpy(fragmentStart + FragmentHeader::SIZE, encodedData.data() + offset, chunkSize);
 
-                        // Resize back to full size for next iteration
-                        buffer.resize(EthernetFrame::MAX_FRAME_SIZE);
+                        chunks.emplace_back(fragmentStart, FragmentHeader::SIZE + chunkSize);
+                        fragmentStart += FragmentHeader::SIZE + chunkSize;
                     }
+                    videoStreamId++;
+
+                    // Send Packets as a single transmission; the fragments buffer is free again once it completes
+                    videoTransmitting.store(true, std::memory_order_release);
+                    sendFrames(chunks, [this](ErrorCode, std::size_t) { videoTransmitting.store(false, std::memory_order_release); });
                 }
             }
         }
 
         // Clear Buffer
-        clearRxBuffer();
+        releaseRxBuffer();
 
-        return ErrorCode::SUCCESS;
+        return batchStatus;
     }
 
-    const std::vector<uint8_t> EmbeddedDevice::convertEnumToBytes(ExpectedPayloadData data) {
-        uint32_t rawData = static_cast<uint32_t>(data);
-        std::vector<uint8_t> bytes = {
-                                        static_cast<uint8_t>((rawData >> 0) & 0xFF),
-                                        static_cast<uint8_t>((rawData >> 8) & 0xFF),
-                                        static_cast<uint8_t>((rawData >> 16) & 0xFF),
-                                        static_cast<uint8_t>((rawData >> 24) & 0xFF)};
+    void EmbeddedDevice::clearRxBuffer() {
+
+        // Initialize method variables
+        std::size_t framesDropped = rxProcessing.frames.size();
+
+        // Empty both buffers before granting credit, so no frame the credit admits is wiped with them
+        {
+            std::lock_guard<std::mutex> lock(rxLock);
+            framesDropped += rxFilling.frames.size();
+            rxFilling.frames.clear();
+            rxFilling.slabUsed = 0;
+        }
+        rxProcessing.frames.clear();
+        rxProcessing.slabUsed = 0;
 
-        const std::vector<uint8_t>& refBytes = bytes;
+        driver->grantCredit(address, framesDropped);
     }
 
-    void EmbeddedDevice::clearRxBuffer() {
-        rxBuffer.clear();
+    void EmbeddedDevice::releaseRxBuffer() {
+
+        // Initialize method variables
+        std::size_t framesConsumed = rxProcessing.frames.size();
+
+        // The processed batch's rx buffer space goes back to the driver as credit once it is empty
+        rxProcessing.frames.clear();
+        rxProcessing.slabUsed = 0;
+        driver->grantCredit(address, framesConsumed);
+    }
+
+    bool EmbeddedDevice::waitForReceivedFrames(std::chrono::milliseconds timeout) {
+        // Sleep until the driver delivers a frame (from its worker when one runs), or the timeout passes
+        std::unique_lock<std::mutex> lock(rxLock);
+        return rxSignal.wait_for(lock, timeout, [this] { return !rxFilling.frames.empty(); });
     }
 
     void EmbeddedDevice::setDestinationAddress(uint32_t address) {
         destinationAddress = address;
     }
+
+    void EmbeddedDevice::setFrameCheckSequence(bool enabled) {
+        frameCheckSequenceEnabled = enabled;
+    }
 }
\ No newline at end of file
@@ -11,55 +11,1210 @@
 #include "ethernet_driver.hpp"
 
 // Standard Incudes
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 // Project Includes
+#include "frame_check_sequence.hpp"
+#include "frame_header_schema.hpp"
 
 namespace EthernetDriverSimulation{
 
-    EthernetDriver::EthernetDriver() {}
+    namespace {
+        // Source of driver ids; 0 is never handed out so an empty thread cache matches no driver
+        std::atomic<uint64_t> nextDriverId{1};
+    }
+
+    EthernetDriver::EthernetDriver(std::size_t queueCount)
+        : timers(static_cast<uint64_t>(TIMER_RESOLUTION.count()), LatencyClock::now()),
+          driverId(nextDriverId.fetch_add(1, std::memory_order_relaxed))
+    {
+        // Every frame slot is preallocated inside the queues, so enqueueing never allocates
+        queueCount = std::max<std::size_t>(queueCount, 1);
+        frameQueues.reserve(queueCount);
+        for (std::size_t i = 0; i < queueCount; ++i) {
+            frameQueues.push_back(std::make_unique<ReceiveQueue>());
+            frameQueues.back()->jitterSource.seed(static_cast<std::minstd_rand::result_type>(i + 1));
+        }
+
+        // Every registered receiver is a member of the broadcast group
+        addressToReceiverMap.insert(BROADCAST_ADDRESS).group = true;
+    }
+
+    EthernetDriver::~EthernetDriver() {
+        stopWorkers();
+    }
+
+    void EthernetDriver::registerReceiver(uint32_t address, PacketReceiver* receiver, std::size_t credits) {
+
+        // Group addresses cannot be taken by a receiver
+        ReceiverEntry& entry = addressToReceiverMap.insert(address);
+        if (entry.group) {
+            return;
+        }
+
+        if (!entry.receiver) {
+            addressToReceiverMap.find(BROADCAST_ADDRESS)->members.push_back(address);
+        }
+
+        entry.receiver = receiver;
+        entry.creditLimited = (credits != UNLIMITED_CREDIT);
+        entry.credits.store(credits, std::memory_order_relaxed);
+    }
+
+    ErrorCode EthernetDriver::joinGroup(uint32_t groupAddress, uint32_t memberAddress) {
+
+        // Ensure the member is a receiver and the group address is free (or already a group)
+        ReceiverEntry *member = addressToReceiverMap.find(memberAddress);
+        if (!member || !member->receiver) {
+            return ErrorCode::INVALID_RECEIVER;
+        }
+
+        ReceiverEntry *existing = addressToReceiverMap.find(groupAddress);
+        if (groupAddress == BROADCAST_ADDRESS || (existing && !existing->group)) {
+            return ErrorCode::INVALID_INPUT;
+        }
+
+        ReceiverEntry& group = addressToReceiverMap.insert(groupAddress);
+        group.group = true;
+        if (std::find(group.members.begin(), group.members.end(), memberAddress) == group.members.end()) {
+            group.members.push_back(memberAddress);
+        }
+
+        return ErrorCode::SUCCESS;
+    }
+
+    ErrorCode EthernetDriver::setLink(uint32_t address, const LinkParameters& parameters) {
+
+        // Ensure a receiver sits behind the link
+        ReceiverEntry *entry = addressToReceiverMap.find(address);
+        if (!entry || !entry->receiver) {
+            return ErrorCode::INVALID_RECEIVER;
+        }
+
+        // Any queue may carry frames to the receiver: each gets room for frames in flight, once
+        for (auto& queue : frameQueues) {
+            queue->delayLine.reserve(LINK_IN_FLIGHT_FRAMES);
+        }
 
-    void EthernetDriver::registerReceiver(uint32_t address, PacketReceiver* receiver) {
-        addressToReceiverMap[address] = receiver;
+        entry->link = std::make_unique<LinkModel>(parameters);
+        return ErrorCode::SUCCESS;
     }
 
-    ErrorCode EthernetDriver::storeSerializedFrame(const uint8_t *frameData){
+    ErrorCode EthernetDriver::getLinkStatistics(uint32_t address, LinkStatistics& statistics) const {
+
+        const ReceiverEntry *entry = addressToReceiverMap.find(address);
+        if (!entry || !entry->link) {
+            return ErrorCode::INVALID_RECEIVER;
+        }
+
+        statistics = entry->link->getStatistics();
+        return ErrorCode::SUCCESS;
+    }
+
+    EthernetDriver::TimerId EthernetDriver::scheduleTimer(std::chrono::nanoseconds delay, TimerCallback callback) {
+
+        // Initialize method variables
+        TimerId timer = TimingWheel::INVALID_TIMER;
+        uint64_t expiry = LatencyClock::now() + static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(delay.count(), 0));
+
+        {
+            std::lock_guard<std::mutex> lock(timerLock);
+            timer = timers.schedule(expiry, std::move(callback));
+            updateNextTimer();
+        }
+
+        // A sleeping worker may have to wake up earlier now
+        ringDoorbell();
+        return timer;
+    }
+
+    bool EthernetDriver::rescheduleTimer(TimerId timer, std::chrono::nanoseconds delay) {
+
+        // Initialize method variables
+        bool pending = false;
+        uint64_t expiry = LatencyClock::now() + static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(delay.count(), 0));
+
+        {
+            std::lock_guard<std::mutex> lock(timerLock);
+            pending = timers.reschedule(timer, expiry);
+            updateNextTimer();
+        }
 
-        // Ensure the buffer is not to full 
-        if(frameBuffer.size() >= MAX_BUFFERED_FRAMES){
+        ringDoorbell();
+        return pending;
+    }
+
+    bool EthernetDriver::cancelTimer(TimerId timer) {
+        std::lock_guard<std::mutex> lock(timerLock);
+        bool pending = timers.cancel(timer);
+        updateNextTimer();
+        return pending;
+    }
+
+    ErrorCode EthernetDriver::leaveGroup(uint32_t groupAddress, uint32_t memberAddress) {
+
+        // Ensure the address is a group the receiver can leave
+        ReceiverEntry *group = addressToReceiverMap.find(groupAddress);
+        if (groupAddress == BROADCAST_ADDRESS || !group || !group->group) {
+            return ErrorCode::INVALID_INPUT;
+        }
+
+        auto member = std::find(group->members.begin(), group->members.end(), memberAddress);
+        if (member == group->members.end()) {
+            return ErrorCode::INVALID_RECEIVER;
+        }
+
+        group->members.erase(member);
+        return ErrorCode::SUCCESS;
+    }
+
+    void EthernetDriver::grantCredit(uint32_t address, std::size_t credits) {
+        ReceiverEntry *entry = addressToReceiverMap.find(address);
+        if (entry && entry->creditLimited) {
+            entry->credits.fetch_add(credits, std::memory_order_release);
+            ringDoorbell();
+        }
+    }
+
+    bool EthernetDriver::hasStoredFrames() {
+        if (transmitPending.load(std::memory_order_acquire)){
+            return true;
+        }
+        for (const auto& queue : frameQueues){
+            if (queue->frames.readable(1) != 0){
+                return true;
+            }
+        }
+        return hasFramesInFlight();
+    }
+
+    bool EthernetDriver::hasFramesInFlight() const {
+        for (const auto& queue : frameQueues){
+            if (!queue->delayLine.empty()){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ErrorCode EthernetDriver::storeSerializedFrame(const uint8_t *frameData, std::size_t size){
+
+        // Initialize method variables
+        std::size_t position = 0;
+
+        // Ensure the frame fits in a single frame
+        SenderStatistics& statistics = localStatistics();
+        if(!frameData || size > EthernetFrame::MAX_FRAME_SIZE){
+            statistics.framesDropped[static_cast<std::size_t>(DropReason::MALFORMED_FRAME)].add(1);
+            return ErrorCode::MALFORMED_FRAME;
+        }
+
+        // Ensure the buffer of the frame's flow is not to full 
+        FrameStore& queue = frameQueues[selectQueue(frameData, size)]->frames;
+        if(queue.claim(1, position) == 0){
+            statistics.framesDropped[static_cast<std::size_t>(DropReason::QUEUE_FULL)].add(1);
+            return ErrorCode::ETHERNET_BUFFER_FULL;
+        }
+
+        // Copy only the bytes on the wire into the claimed slot
+        FrameStore::FrameSlot& slot = queue.slotAt(position);
+        std::memcpy(slot.data.data(), frameData, size);
+        slot.length = size;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        slot.storedAt = LatencyClock::now();
+#endif
+        queue.publish(position, 1);
+        ringDoorbell();
+
+        statistics.framesEnqueued.add(1);
+        statistics.bytesEnqueued.add(size);
+        return ErrorCode::SUCCESS;
+    }
+
+    ErrorCode EthernetDriver::storeSerializedFrame(std::span<const FrameSegment> segments){
+
+        // Initialize method variables
+        std::size_t position = 0;
+
+        // Ensure the gathered frame fits in a single frame
+        std::size_t frameSize = 0;
+        for (const auto& segment : segments){
+            frameSize += segment.length;
+        }
+
+        SenderStatistics& statistics = localStatistics();
+        if(frameSize > EthernetFrame::MAX_FRAME_SIZE){
+            statistics.framesDropped[static_cast<std::size_t>(DropReason::MALFORMED_FRAME)].add(1);
+            return ErrorCode::MALFORMED_FRAME;
+        }
+
+        // Gather the addresses, which may span segments, to pick the flow's queue
+        std::array<uint8_t, FrameHeaderSchema::SOURCE_ADDRESS_FIELD.offset + FrameHeaderSchema::SOURCE_ADDRESS_FIELD.width> addresses = {};
+        std::size_t addressBytes = 0;
+        for (const auto& segment : segments){
+            std::size_t count = std::min(segment.length, addresses.size() - addressBytes);
+            std::memcpy(addresses.data() + addressBytes, segment.data, count);
+            addressBytes += count;
+            if (addressBytes == addresses.size()){
+                break;
+            }
+        }
+
+        // Ensure the buffer of the frame's flow is not to full 
+        FrameStore& queue = frameQueues[selectQueue(addresses.data(), addressBytes)]->frames;
+        if(queue.claim(1, position) == 0){
+            statistics.framesDropped[static_cast<std::size_t>(DropReason::QUEUE_FULL)].add(1);
             return ErrorCode::ETHERNET_BUFFER_FULL;
         }
 
-        // Move the frame in the buffer
-        std::vector<uint8_t> frame(frameData, frameData + EthernetFrame::MAX_FRAME_SIZE);
-        frameBuffer.emplace_back(std::move(frame));
+        // Gather each segment directly into the claimed slot
+        FrameStore::FrameSlot& slot = queue.slotAt(position);
+        uint8_t *frame = slot.data.data();
+        for (const auto& segment : segments){
+            std::memcpy(frame, segment.data, segment.length);
+            frame += segment.length;
+        }
+
+        slot.length = frameSize;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        slot.storedAt = LatencyClock::now();
+#endif
+        queue.publish(position, 1);
+        ringDoorbell();
+
+        statistics.framesEnqueued.add(1);
+        statistics.bytesEnqueued.add(frameSize);
+        return ErrorCode::SUCCESS;
+    }
+
+    ErrorCode EthernetDriver::storeSerializedFrames(std::span<const FramePayload> payloads, std::size_t& framesStored){
+
+        framesStored = 0;
+        ErrorCode status = validatePayloads(payloads);
+        if(ErrorCode::SUCCESS != status){
+            return status;
+        }
+
+        // Frames that did not fit are left to the caller, which gets no XON for them
+        status = enqueueFrames(payloads, framesStored);
+        if(ErrorCode::ETHERNET_BUFFER_FULL == status){
+            localStatistics().framesDropped[static_cast<std::size_t>(DropReason::QUEUE_FULL)].add(payloads.size() - framesStored);
+        }
+
+        return status;
+    }
+
+    ErrorCode EthernetDriver::storeSerializedFramesBlocking(std::span<const FramePayload> payloads){
+
+        // Initialize method variables
+        std::size_t framesStored = 0;
+        ErrorCode status = validatePayloads(payloads);
+
+        if(ErrorCode::SUCCESS != status){
+            return status;
+        }
+
+        for (;;){
+            std::size_t stored = 0;
+            status = enqueueFrames(payloads.subspan(framesStored), stored);
+            framesStored += stored;
+
+            if(ErrorCode::ETHERNET_BUFFER_FULL != status){
+                return status;
+            }
+
+            // XOFF: sleep until the worker consuming the full queue frees a slot
+            localStatistics().enqueueStalls.add(1);
+            if(workersOwnQueues.load(std::memory_order_acquire)){
+                waitForXon(*frameQueues[selectQueue(payloads[framesStored])]);
+                continue;
+            }
+
+            // Nobody else drains the queues; give up once the receivers stop granting credit (and nothing is still arriving)
+            std::size_t queueIndex = selectQueue(payloads[framesStored]);
+            if(pollQueue(queueIndex, MAX_BUFFERED_FRAMES) == 0 && frameQueues[queueIndex]->delayLine.empty()){
+                localStatistics().framesDropped[static_cast<std::size_t>(DropReason::QUEUE_FULL)].add(payloads.size() - framesStored);
+                return ErrorCode::ETHERNET_BUFFER_FULL;
+            }
+        }
+    }
+
+    ErrorCode EthernetDriver::storeSerializedFramesAsync(std::span<const FramePayload> payloads, std::size_t& framesStored, XonCallback onXon){
+
+        framesStored = 0;
+        ErrorCode status = validatePayloads(payloads);
+        if(ErrorCode::SUCCESS != status){
+            return status;
+        }
+
+        status = enqueueFrames(payloads, framesStored);
+        if(ErrorCode::ETHERNET_BUFFER_FULL != status){
+            return status;
+        }
+
+        // XOFF: keep the callback on the queue that refused the next frame
+        ReceiveQueue& queue = *frameQueues[selectQueue(payloads[framesStored])];
+        {
+            std::lock_guard<std::mutex> lock(queue.xonLock);
+            queue.xonWaiters.push_back(std::move(onXon));
+            queue.xoff.store(true, std::memory_order_relaxed);
+        }
+        localStatistics().enqueueStalls.add(1);
+
+        // The consumer may have freed a slot before it could see XOFF; raise the XON here then
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(!queue.frames.full()){
+            signalXon(queue);
+        }
+
+        return status;
+    }
+
+    void EthernetDriver::transmit(std::span<const FramePayload> payloads, TxCompletion onComplete){
+
+        // A malformed transmission stores nothing; it still completes in order with the others
+        ErrorCode status = validatePayloads(payloads);
+        {
+            std::lock_guard<std::mutex> lock(transmitLock);
+            transmitRequests.push_back({std::vector<FramePayload>(payloads.begin(), payloads.end()), 0, status, std::move(onComplete)});
+            transmitPending.store(true, std::memory_order_release);
+        }
+
+        // Store what fits now; the rest follows as the queues drain
+        serviceTransmit();
+        ringDoorbell();
+    }
+
+    std::future<ErrorCode> EthernetDriver::transmit(std::span<const FramePayload> payloads){
+
+        // The completion owns the promise; std::function needs it copyable
+        auto completed = std::make_shared<std::promise<ErrorCode>>();
+        std::future<ErrorCode> future = completed->get_future();
+
+        transmit(payloads, [completed](ErrorCode status, std::size_t) { completed->set_value(status); });
+        return future;
+    }
+
+    ErrorCode EthernetDriver::validatePayloads(std::span<const FramePayload> payloads){
+
+        // Ensure every payload fits in a single frame before anything is stored
+        for (const auto& payload : payloads){
+            if(payload.length > EthernetFrame::MAX_PAYLOAD_SIZE){
+                localStatistics().framesDropped[static_cast<std::size_t>(DropReason::MALFORMED_FRAME)].add(payloads.size());
+                return ErrorCode::MALFORMED_FRAME;
+            }
+        }
+
+        return ErrorCode::SUCCESS;
+    }
+
+    ErrorCode EthernetDriver::enqueueFrames(std::span<const FramePayload> payloads, std::size_t& framesStored){
+
+        // Initialize method variables
+        framesStored = 0;
+        std::size_t position = 0;
+        SenderStatistics& statistics = localStatistics();
+
+        // Store consecutive payloads of the same flow as one batch: one claim and one publish per run.
+        // A run never needs to be longer than a queue holds, however many payloads are left
+        while (framesStored < payloads.size()){
+            const FramePayload& first = payloads[framesStored];
+            std::size_t queueIndex = selectQueue(first);
+
+            std::size_t runLength = 1;
+            while (framesStored + runLength < payloads.size() && runLength < FrameStore::capacity() &&
+                   payloads[framesStored + runLength].destinationAddress == first.destinationAddress &&
+                   payloads[framesStored + runLength].sourceAddress == first.sourceAddress){
+                runLength++;
+            }
+
+            // Claim slots for the whole run at once; store as many frames as fit
+            FrameStore& queue = frameQueues[queueIndex]->frames;
+            std::size_t frameCount = queue.claim(runLength, position);
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            uint64_t storedAt = LatencyClock::now();
+#endif
+
+            // Serialize each frame straight into its slot
+            std::size_t bytesStored = 0;
+            for (std::size_t i = 0; i < frameCount; ++i){
+                const FramePayload& payload = payloads[framesStored + i];
+                FrameStore::FrameSlot& slot = queue.slotAt(position + i);
+                uint8_t *frame = slot.data.data();
+                std::size_t frameSize = EthernetFrame::HEADER_SIZE + payload.length;
+
+                EthernetFrame::writeHeader(frame, payload.destinationAddress, payload.sourceAddress, payload.length, payload.frameCheckSequence);
+                std::memcpy(frame + EthernetFrame::HEADER_SIZE, payload.data, payload.length);
+
+                // Append the trailer over the serialized header and payload
+                if(payload.frameCheckSequence){
+                    writeFrameCheckSequence(frame + frameSize, computeFrameCheckSequence(0, frame, frameSize));
+                    frameSize += EthernetFrame::FCS_SIZE;
+                }
+
+                slot.length = frameSize;
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                slot.storedAt = storedAt;
+#endif
+                bytesStored += frameSize;
+            }
+
+            // Publish the run to the queue's consumer
+            queue.publish(position, frameCount);
+            framesStored += frameCount;
+            if(frameCount != 0){
+                ringDoorbell();
+                statistics.framesEnqueued.add(frameCount);
+                statistics.bytesEnqueued.add(bytesStored);
+            }
+
+            // Report when the run did not fit in its buffer; later frames of the flow must not overtake it
+            if(frameCount < runLength){
+                return ErrorCode::ETHERNET_BUFFER_FULL;
+            }
+        }
+
         return ErrorCode::SUCCESS;
     }
 
     void EthernetDriver::processStoredFrame() {
 
-        // Loop and send each frame
-        for (const auto& frame : frameBuffer){
-            forwardSerializedFrame(frame);
+        // The worker threads own the queues while they run
+        if (workersRunning.load(std::memory_order_acquire)){
+            return;
+        }
+
+        // Service each queue once (at most one full buffer per queue per call), then refill them from pending transmissions
+        for (std::size_t i = 0; i < frameQueues.size(); ++i){
+            serviceQueue(i);
+        }
+        serviceTransmit();
+        serviceTimers();
+    }
+
+    void EthernetDriver::startWorkers(std::size_t workerCount) {
+
+        // Ensure the workers are only started once
+        if (workersRunning.exchange(true, std::memory_order_acq_rel)){
+            return;
+        }
+        workersOwnQueues.store(true, std::memory_order_release);
+
+        // Each queue keeps a single consumer: worker i services queues i, i + workerCount, ...
+        if (workerCount == 0 || workerCount > frameQueues.size()){
+            workerCount = frameQueues.size();
+        }
+
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i){
+            workers.emplace_back(&EthernetDriver::runWorker, this, i, workerCount);
+        }
+    }
+
+    void EthernetDriver::stopWorkers() {
+
+        // Signal the workers, wake the sleeping ones and wait for their final drain
+        workersRunning.store(false, std::memory_order_release);
+
+        doorbell.fetch_add(1, std::memory_order_release);
+        doorbell.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(doorbellLock);
+        }
+        doorbellSignal.notify_all();
+
+        for (auto& worker : workers){
+            if (worker.joinable()){
+                worker.join();
+            }
+        }
+        workers.clear();
+
+        // Senders asleep on a full queue drain it themselves from now on (not before: a worker may still be draining it)
+        workersOwnQueues.store(false, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto& queue : frameQueues){
+            if (queue->xoff.load(std::memory_order_relaxed)){
+                signalXon(*queue);
+            }
+        }
+    }
+
+    void EthernetDriver::setCoalescing(const CoalescingParameters& parameters, InterruptHandler handler) {
+        coalescing = parameters;
+        coalescing.frameThreshold = std::clamp<std::size_t>(parameters.frameThreshold, 1, MAX_BUFFERED_FRAMES);
+        interruptHandler = std::move(handler);
+    }
+
+    std::size_t EthernetDriver::pollQueue(std::size_t queueIndex, std::size_t budget) {
+        ReceiveQueue& queue = *frameQueues[queueIndex];
+        releaseArrivals(queue);
+        std::size_t framesForwarded = forwardQueue(queue, budget);
+        recordBatch(queue, framesForwarded);
+        return framesForwarded;
+    }
+
+    FlowControlStatistics EthernetDriver::getFlowControlStatistics() const {
+
+        // Initialize method variables
+        FlowControlStatistics flowControl = {};
+
+        {
+            std::lock_guard<std::mutex> lock(senderStatisticsLock);
+            for (const auto& sender : senderStatistics){
+                flowControl.framesDropped += sender.second->framesDropped[static_cast<std::size_t>(DropReason::QUEUE_FULL)].read();
+                flowControl.enqueueStalls += sender.second->enqueueStalls.read();
+            }
+        }
+
+        for (const auto& queue : frameQueues){
+            flowControl.creditStalls += queue->statistics.creditStalls.read();
+        }
+
+        return flowControl;
+    }
+
+    void EthernetDriver::getStatistics(DriverStatistics& snapshot) const {
+
+        // Start over, keeping the vectors' storage
+        std::vector<uint64_t> highWaterMarks = std::move(snapshot.queueHighWaterMarks);
+        std::vector<FlowStatistics> flows = std::move(snapshot.flows);
+        highWaterMarks.clear();
+        flows.clear();
+        snapshot = DriverStatistics{};
+
+        // Sending side: one set of counters per thread that stored frames
+        {
+            std::lock_guard<std::mutex> lock(senderStatisticsLock);
+            for (const auto& sender : senderStatistics){
+                snapshot.framesEnqueued += sender.second->framesEnqueued.read();
+                snapshot.bytesEnqueued += sender.second->bytesEnqueued.read();
+                snapshot.enqueueStalls += sender.second->enqueueStalls.read();
+                for (std::size_t i = 0; i < DROP_REASON_COUNT; ++i){
+                    snapshot.framesDropped[i] += sender.second->framesDropped[i].read();
+                }
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                sender.second->processLatency.collect(snapshot.processLatency);
+#endif
+            }
+        }
+
+        // Forwarding side: one set of counters per queue, each kept by the queue's consumer
+        for (const auto& queue : frameQueues){
+            snapshot.framesForwarded += queue->statistics.framesForwarded.read();
+            snapshot.bytesForwarded += queue->statistics.bytesForwarded.read();
+            snapshot.creditStalls += queue->statistics.creditStalls.read();
+            snapshot.framesDropped[static_cast<std::size_t>(DropReason::UNKNOWN_DESTINATION)] += queue->statistics.unknownDestinations.read();
+            snapshot.untrackedFlowFrames += queue->flows.untrackedFrames.read();
+            snapshot.untrackedFlowBytes += queue->flows.untrackedBytes.read();
+            highWaterMarks.push_back(queue->statistics.highWaterMark.read());
+            queue->flows.collect(flows);
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            queue->statistics.forwardLatency.collect(snapshot.forwardLatency);
+#endif
+        }
+
+        snapshot.queueHighWaterMarks = std::move(highWaterMarks);
+        snapshot.flows = std::move(flows);
+    }
+
+#if defined(EDS_LATENCY_HISTOGRAMS)
+    void EthernetDriver::recordProcessLatency(uint64_t nanoseconds) {
+        // Processing threads keep their histogram next to their sending counters
+        localStatistics().processLatency.record(nanoseconds);
+    }
+#endif
+
+    EthernetDriver::BatchHistogram EthernetDriver::getBatchHistogram() const {
+
+        // Initialize method variables
+        BatchHistogram histogram = {};
+
+        for (const auto& queue : frameQueues){
+            for (std::size_t i = 0; i < BATCH_HISTOGRAM_SIZE; ++i){
+                histogram[i] += queue->batchHistogram[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        return histogram;
+    }
+
+    std::size_t EthernetDriver::selectQueue(uint32_t destinationAddress, uint32_t sourceAddress) const {
+
+        // A single queue needs no hashing
+        if (frameQueues.size() == 1){
+            return 0;
+        }
+
+        // Fibonacci hash of the flow; the high bits are the well mixed ones
+        uint64_t flow = (static_cast<uint64_t>(sourceAddress) << 32) | destinationAddress;
+        flow *= 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(flow >> 32) % frameQueues.size();
+    }
+
+    std::size_t EthernetDriver::selectQueue(const uint8_t* frame, std::size_t size) const {
+
+        // Frames too short to carry both addresses all go to the first queue
+        if (size < FrameHeaderSchema::SOURCE_ADDRESS_FIELD.offset + FrameHeaderSchema::SOURCE_ADDRESS_FIELD.width){
+            return 0;
         }
 
-        // Clear frame buffer
-        frameBuffer.clear();
+        return selectQueue(FrameHeaderSchema::decode<FrameHeaderSchema::DESTINATION_ADDRESS_FIELD>(frame),
+                           FrameHeaderSchema::decode<FrameHeaderSchema::SOURCE_ADDRESS_FIELD>(frame));
     }
 
-    void EthernetDriver::forwardSerializedFrame(const std::vector<uint8_t>& frame) {
+    std::size_t EthernetDriver::selectQueue(const FramePayload& payload) const {
+        // Both addresses are held as they appear on the wire
+        return selectQueue(FrameHeaderSchema::bytesToAddress(payload.destinationAddress),
+                           FrameHeaderSchema::bytesToAddress(payload.sourceAddress));
+    }
+
+    std::size_t EthernetDriver::forwardQueue(ReceiveQueue& queue, std::size_t limit) {
+
+        // Initialize method variables
+        std::size_t framesForwarded = 0;
+        std::size_t framesHeld = 0;
+
+        // Track the deepest the queue has been
+        queue.statistics.highWaterMark.raiseTo(queue.frames.readable(MAX_BUFFERED_FRAMES));
+
+        // Loop and send each frame published so far, in queue order, until a receiver runs out of credit.
+        // Forwarded frames are delivered from their slots in batches, so the slots are held until then
+        while (framesForwarded < limit){
+            const FrameStore::FrameSlot *slot = queue.frames.peek(framesHeld);
+            if (!slot){
+                if (framesHeld != FrameStore::capacity()){
+                    break;
+                }
+
+                // Every slot is held: deliver them so the rest of the budget can be forwarded
+                flushDeliveries(queue);
+                queue.frames.pop(framesHeld);
+                framesHeld = 0;
+                continue;
+            }
+            if (!forwardSerializedFrame(queue, slot->data.data(), slot->length)){
+                break;
+            }
+
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            queue.statistics.forwardLatency.record(LatencyClock::now() - slot->storedAt);
+#endif
+            framesHeld++;
+            framesForwarded++;
+        }
+
+        // Hand the forwarded slots back to the producers once the receivers have the frames
+        flushDeliveries(queue);
+        queue.frames.pop(framesHeld);
+
+        // Slots were freed: XON for any sender waiting on this queue, and the worker storing pending transmissions
+        if (framesForwarded != 0){
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (queue.xoff.load(std::memory_order_relaxed)){
+                signalXon(queue);
+            }
+            if (transmitPending.load(std::memory_order_relaxed)){
+                ringDoorbell();
+            }
+        }
+
+        return framesForwarded;
+    }
+
+    void EthernetDriver::signalXon(ReceiveQueue& queue) {
+
+        // Initialize method variables
+        std::vector<XonCallback> waiters;
+
+        // Take the waiters under the lock but raise them outside it, so they may enqueue (and wait) again
+        {
+            std::lock_guard<std::mutex> lock(queue.xonLock);
+            queue.xoff.store(false, std::memory_order_relaxed);
+            waiters.swap(queue.xonWaiters);
+        }
+
+        for (auto& waiter : waiters){
+            waiter();
+        }
+    }
+
+    void EthernetDriver::waitForXon(ReceiveQueue& queue) {
+
+        // The flag outlives the call: an XON raised after this returned still finds it
+        auto xon = std::make_shared<std::atomic<bool>>(false);
+
+        {
+            std::lock_guard<std::mutex> lock(queue.xonLock);
+            queue.xonWaiters.push_back([xon] {
+                xon->store(true, std::memory_order_release);
+                xon->notify_one();
+            });
+            queue.xoff.store(true, std::memory_order_relaxed);
+        }
+
+        // Still XOFF after arming: the consumer may have freed a slot before it could see XOFF, or the
+        // workers may have stopped and left the queue to this thread; raise the XON here then
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(queue.xoff.load(std::memory_order_relaxed) && (!queue.frames.full() || !workersOwnQueues.load(std::memory_order_relaxed))){
+            signalXon(queue);
+        }
+
+        xon->wait(false, std::memory_order_acquire);
+    }
+
+    bool EthernetDriver::serviceQueue(std::size_t queueIndex) {
+
+        // Initialize method variables
+        ReceiveQueue& queue = *frameQueues[queueIndex];
+
+        // Frames that arrived over an emulated link are handed over first; they left the queue earlier
+        bool framesArrived = releaseArrivals(queue) != 0;
+
+        // Without coalescing or a handler every waiting frame is delivered straight away
+        if (coalescing.frameThreshold == 1 && coalescing.timeThreshold.count() == 0 && !interruptHandler){
+            std::size_t framesForwarded = forwardQueue(queue, MAX_BUFFERED_FRAMES);
+            if (framesForwarded != 0){
+                recordBatch(queue, framesForwarded);
+            }
+            return framesForwarded != 0 || framesArrived;
+        }
+
+        // Nothing waiting: the coalescing timer is idle
+        std::size_t framesWaiting = queue.frames.readable(coalescing.frameThreshold);
+        if (framesWaiting == 0){
+            queue.framesWaiting = false;
+            return framesArrived;
+        }
+
+        // The timer starts when the consumer first sees a frame waiting
+        if (framesWaiting < coalescing.frameThreshold){
+            auto now = std::chrono::steady_clock::now();
+            if (!queue.framesWaiting){
+                queue.framesWaiting = true;
+                queue.waitingSince = now;
+            }
+            if (now - queue.waitingSince < coalescing.timeThreshold){
+                return framesArrived;
+            }
+        }
+
+        // Due: raise the interrupt so the handler polls, or deliver the batch here. Only frames
+        // forwarded count as progress; a batch held back by credit waits for grantCredit's doorbell
+        queue.framesWaiting = false;
+        uint64_t forwardedBefore = queue.statistics.framesForwarded.read();
+        if (interruptHandler){
+            interruptHandler(queueIndex);
+        }
+        else {
+            pollQueue(queueIndex, MAX_BUFFERED_FRAMES);
+        }
+
+        return queue.statistics.framesForwarded.read() != forwardedBefore || framesArrived;
+    }
+
+    void EthernetDriver::recordBatch(ReceiveQueue& queue, std::size_t batchSize) {
+        // Only the queue's consumer writes its histogram; the atomics let getBatchHistogram read it meanwhile
+        std::atomic<uint64_t>& bucket = queue.batchHistogram[std::min(batchSize, BATCH_HISTOGRAM_SIZE - 1)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    bool EthernetDriver::serviceTransmit() {
+
+        // Initialize method variables
+        bool progress = false;
+        std::vector<TransmitRequest> completed;
+
+        if (!transmitPending.load(std::memory_order_acquire)){
+            return false;
+        }
+
+        // Store the oldest transmissions first, until a queue is full
+        {
+            std::lock_guard<std::mutex> lock(transmitLock);
+            while (!transmitRequests.empty()){
+                TransmitRequest& request = transmitRequests.front();
+
+                // Refused as malformed when it was handed over
+                std::size_t stored = 0;
+                ErrorCode status = request.status;
+                if (ErrorCode::SUCCESS == status){
+                    status = enqueueFrames(std::span<const FramePayload>(request.payloads).subspan(request.framesStored), stored);
+                }
+                request.framesStored += stored;
+                progress = progress || (stored != 0);
+
+                // XOFF: wait for the queues to drain
+                if (ErrorCode::ETHERNET_BUFFER_FULL == status){
+                    if (stored != 0){
+                        localStatistics().enqueueStalls.add(1);
+                    }
+                    break;
+                }
+
+                // Stored (or refused as malformed): the sender's buffers are free again
+                request.status = status;
+                completed.push_back(std::move(request));
+                transmitRequests.pop_front();
+            }
+            transmitPending.store(!transmitRequests.empty(), std::memory_order_release);
+        }
+
+        // Complete outside the lock so the callbacks may transmit again
+        for (auto& request : completed){
+            if (request.onComplete){
+                request.onComplete(request.status, request.framesStored);
+            }
+        }
+
+        return progress || !completed.empty();
+    }
+
+    std::size_t EthernetDriver::serviceTimers() {
+
+        // Initialize method variables
+        std::size_t timersFired = 0;
+        TimerCallback callback;
+        uint64_t now = LatencyClock::now();
+
+        // Nothing due yet: leave the lock alone
+        if (nextTimerAt.load(std::memory_order_acquire) > now){
+            return 0;
+        }
+
+        // Take one due timer at a time and run it outside the lock, so callbacks may use the timers too
+        for (;;){
+            {
+                std::lock_guard<std::mutex> lock(timerLock);
+                bool due = timers.expire(now, callback);
+                updateNextTimer();
+                if (!due){
+                    break;
+                }
+            }
+
+            callback();
+            timersFired++;
+        }
+
+        return timersFired;
+    }
+
+    void EthernetDriver::updateNextTimer() {
+        // Called under the timer lock; lets the service loop check for due timers without taking it
+        nextTimerAt.store(timers.nextExpiry(), std::memory_order_release);
+    }
+
+    bool EthernetDriver::serviceWorkerQueues(std::size_t workerIndex, std::size_t workerCount) {
+
+        // Initialize method variables
+        bool serviced = false;
+
+        for (std::size_t i = workerIndex; i < frameQueues.size(); i += workerCount){
+            serviced = serviceQueue(i) || serviced;
+        }
+
+        // The first worker also carries the pending transmissions and the timers
+        if (workerIndex == 0){
+            serviced = serviceTransmit() || serviced;
+            serviced = (serviceTimers() != 0) || serviced;
+        }
+
+        return serviced;
+    }
+
+    uint64_t EthernetDriver::nextDeadline(std::size_t workerIndex, std::size_t workerCount) {
+
+        // Initialize method variables
+        uint64_t deadline = (workerIndex == 0) ? nextTimerAt.load(std::memory_order_acquire) : TimingWheel::NEVER;
+
+        for (std::size_t i = workerIndex; i < frameQueues.size(); i += workerCount){
+            const ReceiveQueue& queue = *frameQueues[i];
+            if (!queue.delayLine.empty()){
+                deadline = std::min(deadline, queue.delayLine.nextArrival());
+            }
+
+            // Frames short of the coalescing frame threshold are due once the first has waited long enough
+            if (queue.framesWaiting){
+                uint64_t waitedEnough = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    (queue.waitingSince + coalescing.timeThreshold).time_since_epoch()).count());
+                deadline = std::min(deadline, waitedEnough);
+            }
+        }
+
+        return deadline;
+    }
+
+    void EthernetDriver::ringDoorbell() {
+        // Only pay for the wake up when a worker sleeps; pairs with the fence in runWorker
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepingWorkers.load(std::memory_order_relaxed) != 0){
+            doorbell.fetch_add(1, std::memory_order_release);
+            doorbell.notify_all();
+
+            // Workers sleeping until a deadline wait on the condition variable instead
+            {
+                std::lock_guard<std::mutex> lock(doorbellLock);
+            }
+            doorbellSignal.notify_all();
+        }
+    }
+
+    void EthernetDriver::runWorker(std::size_t workerIndex, std::size_t workerCount) {
+
+#if defined(__linux__)
+        // Pin the worker so its queues' slots stay in one core's cache
+        unsigned int coreCount = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(workerIndex % coreCount, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+
+        // Service the queues (and transmissions) until stopped
+        while (workersRunning.load(std::memory_order_acquire)){
+            if (serviceWorkerQueues(workerIndex, workerCount)){
+                continue;
+            }
+
+            // No progress: arm the doorbell, then look once more so work published meanwhile is not slept through
+            sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            uint32_t rung = doorbell.load(std::memory_order_acquire);
+            if (serviceWorkerQueues(workerIndex, workerCount)){
+                sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // Sleep until the doorbell rings (new frames, credit, queue space, stop), or the next timer, link
+            // arrival or coalescing deadline is due. Frames held back by credit never wake the worker by themselves
+            if (workersRunning.load(std::memory_order_acquire)){
+                uint64_t deadline = nextDeadline(workerIndex, workerCount);
+                if (deadline == TimingWheel::NEVER){
+                    doorbell.wait(rung, std::memory_order_acquire);
+                }
+                else {
+                    std::unique_lock<std::mutex> lock(doorbellLock);
+                    doorbellSignal.wait_until(lock,
+                                              std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(deadline))),
+                                              [this, rung]() { return doorbell.load(std::memory_order_acquire) != rung; });
+                }
+            }
+            sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // Forward (and transmit) whatever was published before the stop, regardless of the thresholds
+        bool progress = true;
+        while (progress){
+            progress = (workerIndex == 0) && serviceTransmit();
+            for (std::size_t i = workerIndex; i < frameQueues.size(); i += workerCount){
+                progress = (pollQueue(i, MAX_BUFFERED_FRAMES) != 0) || progress;
+            }
+        }
+    }
+
+    SenderStatistics& EthernetDriver::localStatistics() {
+
+        // Each thread remembers its counters of the driver it used last
+        thread_local uint64_t cachedDriverId = 0;
+        thread_local SenderStatistics *cachedStatistics = nullptr;
+
+        if (cachedDriverId == driverId){
+            return *cachedStatistics;
+        }
+
+        // First use on this thread (or after using another driver): find or add its counters
+        std::lock_guard<std::mutex> lock(senderStatisticsLock);
+        std::thread::id thread = std::this_thread::get_id();
+        auto sender = std::find_if(senderStatistics.begin(), senderStatistics.end(),
+                                   [thread](const auto& entry) { return entry.first == thread; });
+        if (sender == senderStatistics.end()){
+            senderStatistics.emplace_back(thread, std::make_unique<SenderStatistics>());
+            sender = std::prev(senderStatistics.end());
+        }
+
+        cachedDriverId = driverId;
+        cachedStatistics = sender->second.get();
+        return *cachedStatistics;
+    }
+
+    void EthernetDriver::countForwarded(ReceiveQueue& queue, const uint8_t* frame, std::size_t size) {
+
+        // Initialize method variables
+        uint32_t sourceAddress = FrameHeaderSchema::decode<FrameHeaderSchema::SOURCE_ADDRESS_FIELD>(frame);
+        uint32_t destinationAddress = FrameHeaderSchema::decode<FrameHeaderSchema::DESTINATION_ADDRESS_FIELD>(frame);
+
+        queue.statistics.framesForwarded.add(1);
+        queue.statistics.bytesForwarded.add(size);
+
+        // Flows come in runs: try the last one before probing the table
+        FlowStatisticsTable::Entry *flow = queue.lastFlow;
+        if (!flow || flow->sourceAddress != sourceAddress || flow->destinationAddress != destinationAddress){
+            flow = queue.flows.find(sourceAddress, destinationAddress);
+            queue.lastFlow = flow;
+        }
+
+        if (flow){
+            flow->frames.add(1);
+            flow->bytes.add(size);
+        }
+        else {
+            queue.flows.untrackedFrames.add(1);
+            queue.flows.untrackedBytes.add(size);
+        }
+    }
+
+    bool EthernetDriver::takeCredit(ReceiveQueue& queue, ReceiverEntry& entry) {
+
+        // Receivers without flow control always have room
+        if (!entry.creditLimited) {
+            return true;
+        }
+
+        std::size_t credits = entry.credits.load(std::memory_order_acquire);
+        do {
+            if (credits == 0) {
+                queue.statistics.creditStalls.add(1);
+                return false;
+            }
+        } while (!entry.credits.compare_exchange_weak(credits, credits - 1, std::memory_order_acquire));
+
+        return true;
+    }
+
+    bool EthernetDriver::forwardSerializedFrame(ReceiveQueue& queue, const uint8_t* frame, std::size_t size) {
         
         // Retrieve the destination address from the packets
         // !!There is an assumption here that the memory address is always correct!! 
-        uint32_t destinationMemoryAddress = 0;
-        for (size_t i = 0; i < 4; ++i) {
-            destinationMemoryAddress |= (static_cast<uint32_t>(frame[i]) << (8 * i));
+        uint32_t destinationMemoryAddress = FrameHeaderSchema::decode<FrameHeaderSchema::DESTINATION_ADDRESS_FIELD>(frame);
+
+        // Find destination object, trying the queue's last destination first (flows come in runs)
+        ReceiverEntry *entry = queue.lastReceiver;
+        if (!entry || queue.lastDestination != destinationMemoryAddress || queue.lastGeneration != addressToReceiverMap.getGeneration()) {
+            entry = addressToReceiverMap.find(destinationMemoryAddress);
+
+            // Frames for unknown addresses are consumed without delivery
+            if (!entry) {
+                queue.statistics.unknownDestinations.add(1);
+                return true;
+            }
+
+            queue.lastDestination = destinationMemoryAddress;
+            queue.lastReceiver = entry;
+            queue.lastGeneration = addressToReceiverMap.getGeneration();
+        }
+
+        // Unicast: take one credit; without any the frame waits in its queue
+        if (!entry->group) {
+            if (!deliverFrame(queue, destinationMemoryAddress, *entry, frame, size)) {
+                return false;
+            }
+
+            countForwarded(queue, frame, size);
+            return true;
+        }
+
+        // Group: every member but the sender gets the frame from this same slot. A member without
+        // credit holds the slot; the ones already served are not served again when it resumes
+        uint32_t sourceMemoryAddress = FrameHeaderSchema::decode<FrameHeaderSchema::SOURCE_ADDRESS_FIELD>(frame);
+        while (queue.membersServed < entry->members.size()) {
+            uint32_t memberAddress = entry->members[queue.membersServed];
+            ReceiverEntry *member = addressToReceiverMap.find(memberAddress);
+
+            if (member && memberAddress != sourceMemoryAddress && !deliverFrame(queue, memberAddress, *member, frame, size)) {
+                return false;
+            }
+            queue.membersServed++;
+        }
+
+        // The last member has it: the slot can go back to the producers
+        queue.membersServed = 0;
+        countForwarded(queue, frame, size);
+        return true;
+    }
+
+    bool EthernetDriver::deliverFrame(ReceiveQueue& queue, uint32_t address, ReceiverEntry& entry, const uint8_t* frame, std::size_t size) {
+
+        // A frame going over a link needs room on the delay line before it takes the receiver's credit
+        if (entry.link && queue.delayLine.full()) {
+            return false;
+        }
+
+        if (!takeCredit(queue, entry)) {
+            return false;
         }
 
-        // Find destination object
-        auto destObject = addressToReceiverMap.find(destinationMemoryAddress);
+        if (!entry.link) {
+            queueDelivery(queue, *entry.receiver, frame, size);
+            return true;
+        }
+
+        // On the wire: the frame leaves its slot and travels on the queue's delay line
+        uint64_t arrival = entry.link->schedule(size, LatencyClock::now(), queue.jitterSource);
+        queue.delayLine.push(arrival, address, frame, size);
+        return true;
+    }
+
+    std::size_t EthernetDriver::releaseArrivals(ReceiveQueue& queue) {
+
+        // Initialize method variables
+        std::size_t framesArrived = 0;
+
+        if (queue.delayLine.empty()) {
+            return 0;
+        }
+
+        // Hand over every frame whose last bit has arrived, in arrival order
+        uint64_t now = LatencyClock::now();
+        while (const LinkDelayLine::Frame *frame = queue.delayLine.due(now)) {
+            ReceiverEntry *entry = addressToReceiverMap.find(frame->address);
+            queueDelivery(queue, *entry->receiver, frame->data.data(), frame->length);
+
+            std::size_t payloadSize = 0;
+            if (frame->length >= EthernetFrame::HEADER_SIZE) {
+                payloadSize = std::min<std::size_t>(FrameHeaderSchema::decode<FrameHeaderSchema::PAYLOAD_LENGTH_FIELD>(frame->data.data()),
+                                                    frame->length - EthernetFrame::HEADER_SIZE);
+            }
+            entry->link->countDelivered(frame->length, payloadSize, frame->arrival);
+
+            // Popped frames keep their bytes until the next push, which only this thread makes after the flush
+            queue.delayLine.pop();
+            framesArrived++;
+        }
+
+        flushDeliveries(queue);
+        return framesArrived;
+    }
+
+    void EthernetDriver::queueDelivery(ReceiveQueue& queue, PacketReceiver& receiver, const uint8_t* frame, std::size_t size) {
+
+        // A batch goes to one receiver: hand it over when the frames change receiver or it is full
+        if (queue.deliveryCount != 0 && (queue.deliveryReceiver != &receiver || queue.deliveryCount == queue.deliveries.size())) {
+            flushDeliveries(queue);
+        }
+
+        queue.deliveryReceiver = &receiver;
+        queue.deliveries[queue.deliveryCount++] = {frame, size};
+    }
+
+    void EthernetDriver::flushDeliveries(ReceiveQueue& queue) {
+
+        // Initialize method variables
+        std::size_t count = queue.deliveryCount;
+
+        if (count == 0) {
+            return;
+        }
 
-        if (destObject != addressToReceiverMap.end()) {
-            destObject->second->receiveFrame(frame.data(), frame.size());
-        } 
+        // Empty the batch before handing it over, so the receiver sees each frame once
+        queue.deliveryCount = 0;
+        queue.deliveryReceiver->receiveFrames(std::span<const FrameRef>(queue.deliveries.data(), count));
     }
-}
\ No newline at end of file
+}
@@ -36,22 +36,23 @@ namespace EthernetDriverSimulation {
     }
 
     /**
-     * @brief Function to take in frame and given the length and data return enumeration signifying the type of frame
+     * @brief Function to take in the payload length and first payload byte and return enumeration signifying the type of frame
      * 
-     * @param[in] frame - EthernetFrame
+     * @param[in] payloadLength - uint16_t
+     * @param[in] firstByte - uint8_t
      * 
      * @return ExpectedPayloadData
      */
-    ExpectedPayloadData findFrameType( EthernetFrame& frame) {
+    static ExpectedPayloadData classifyPayload(uint16_t payloadLength, uint8_t firstByte) {
         
         // If the payload length is greater than 3 bytes -> Video Data Packet
-        if (frame.payloadLength > 3){
+        if (payloadLength > CONTROL_PAYLOAD_SIZE){
             return ExpectedPayloadData::VIDEO_DATA;
         } 
         // If the payload length is exactly 3 it should match one expected payload data
-        else if(frame.payloadLength == 3) {
+        else if(payloadLength == CONTROL_PAYLOAD_SIZE) {
 
-            switch (frame.payload[0]) {
+            switch (firstByte) {
                 case 0x10: return ExpectedPayloadData::HANDSHAKE;
                 case 0x20: return ExpectedPayloadData::ACKNOWLEDGEMENT;
                 case 0x30: return ExpectedPayloadData::VIDEO_REQUEST;
@@ -64,4 +65,27 @@ namespace EthernetDriverSimulation {
             return ExpectedPayloadData::UNKNOWN_PACKET;
         } 
     }
+
+    /**
+     * @brief Function to take in frame and given the length and data return enumeration signifying the type of frame
+     * 
+     * @param[in] frame - EthernetFrame
+     * 
+     * @return ExpectedPayloadData
+     */
+    ExpectedPayloadData findFrameType( EthernetFrame& frame) {
+        return classifyPayload(frame.payloadLength, frame.payload[0]);
+    }
+
+    /**
+     * @brief Function to take in a frame view and given the length and data return enumeration signifying the type of frame
+     * 
+     * @param[in] frame - FrameView
+     * 
+     * @return ExpectedPayloadData
+     */
+    ExpectedPayloadData findFrameType(const FrameView& frame) {
+        std::span<const uint8_t> payload = frame.payload();
+        return classifyPayload(static_cast<uint16_t>(payload.size()), payload.empty() ? 0 : payload[0]);
+    }
 }
\ No newline at end of file
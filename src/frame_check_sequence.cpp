@@ -0,0 +1,175 @@
+/**
+ * @file frame_check_sequence.cpp
+ *
+ * @brief Implementation of the frame check sequence (CRC-32C) used by the optional frame trailer
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Header Includes
+#include "frame_check_sequence.hpp"
+
+// Standard Incudes
+#include <array>
+#include <atomic>
+#include <cstring>
+
+// Project Includes
+
+// The crc32 instruction path is only built for 64 bit x86 compilers that support per function targets
+#if defined(__GNUC__) && defined(__x86_64__)
+#define EDS_FCS_X86_CRC32 1
+#include <immintrin.h>
+#endif
+
+namespace EthernetDriverSimulation {
+
+    /**
+     * @defgroup Private constant definitions
+     * @{
+     */
+    // Reflected Castagnoli polynomial, the one implemented by the SSE4.2 crc32 instruction
+    static constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Build the slice-by-8 lookup tables at compile time
+     */
+    static constexpr std::array<std::array<uint32_t, 256>, 8> buildSliceTables() {
+        std::array<std::array<uint32_t, 256>, 8> tables{};
+
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+            }
+            tables[0][i] = crc;
+        }
+
+        for (std::size_t slice = 1; slice < 8; ++slice) {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t previous = tables[slice - 1][i];
+                tables[slice][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+            }
+        }
+
+        return tables;
+    }
+
+    static constexpr std::array<std::array<uint32_t, 256>, 8> SLICE_TABLES = buildSliceTables();
+
+    /**
+     * @defgroup Private variable declarations
+     * @{
+     */
+    static std::atomic<uint64_t> framesChecked{0};
+    static std::atomic<uint64_t> fcsErrors{0};
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Portable CRC-32C processing 8 bytes per step (slice-by-8)
+     */
+    static uint32_t computeSliceBy8(uint32_t crc, const uint8_t *data, std::size_t length) {
+        while (length >= 8) {
+            uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                                  (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24));
+            uint32_t high = static_cast<uint32_t>(data[4]) | (static_cast<uint32_t>(data[5]) << 8) |
+                            (static_cast<uint32_t>(data[6]) << 16) | (static_cast<uint32_t>(data[7]) << 24);
+
+            crc = SLICE_TABLES[7][low & 0xFF] ^ SLICE_TABLES[6][(low >> 8) & 0xFF] ^
+                  SLICE_TABLES[5][(low >> 16) & 0xFF] ^ SLICE_TABLES[4][low >> 24] ^
+                  SLICE_TABLES[3][high & 0xFF] ^ SLICE_TABLES[2][(high >> 8) & 0xFF] ^
+                  SLICE_TABLES[1][(high >> 16) & 0xFF] ^ SLICE_TABLES[0][high >> 24];
+
+            data += 8;
+            length -= 8;
+        }
+
+        while (length--) {
+            crc = (crc >> 8) ^ SLICE_TABLES[0][(crc ^ *data++) & 0xFF];
+        }
+
+        return crc;
+    }
+
+#ifdef EDS_FCS_X86_CRC32
+    /**
+     * @brief CRC-32C using the SSE4.2 crc32 instruction, 8 bytes per instruction
+     */
+    __attribute__((target("sse4.2")))
+    static uint32_t computeSse42(uint32_t crc, const uint8_t *data, std::size_t length) {
+        uint64_t crc64 = crc;
+
+        while (length >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            crc64 = _mm_crc32_u64(crc64, word);
+            data += 8;
+            length -= 8;
+        }
+
+        crc = static_cast<uint32_t>(crc64);
+        while (length--) {
+            crc = _mm_crc32_u8(crc, *data++);
+        }
+
+        return crc;
+    }
+#endif
+
+    uint32_t computeFrameCheckSequence(uint32_t crc, const uint8_t *data, std::size_t length) {
+        // Pre and post inversion keep chained calls equivalent to one call over the whole range
+        crc = ~crc;
+
+#ifdef EDS_FCS_X86_CRC32
+        static const bool hasCrc32Instruction = __builtin_cpu_supports("sse4.2");
+
+        if (hasCrc32Instruction) {
+            return ~computeSse42(crc, data, length);
+        }
+#endif
+
+        return ~computeSliceBy8(crc, data, length);
+    }
+
+    uint32_t computeFrameCheckSequencePortable(uint32_t crc, const uint8_t *data, std::size_t length) {
+        return ~computeSliceBy8(~crc, data, length);
+    }
+
+    void writeFrameCheckSequence(uint8_t *trailer, uint32_t crc) {
+        trailer[0] = static_cast<uint8_t>((crc >> 24) & 0xFF);
+        trailer[1] = static_cast<uint8_t>((crc >> 16) & 0xFF);
+        trailer[2] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+        trailer[3] = static_cast<uint8_t>(crc & 0xFF);
+    }
+
+    bool verifyFrameCheckSequence(const uint8_t *frame, std::size_t coveredLength) {
+        const uint8_t *trailer = frame + coveredLength;
+        uint32_t expected = (static_cast<uint32_t>(trailer[0]) << 24) | (static_cast<uint32_t>(trailer[1]) << 16) |
+                            (static_cast<uint32_t>(trailer[2]) << 8) | static_cast<uint32_t>(trailer[3]);
+
+        bool matches = computeFrameCheckSequence(0, frame, coveredLength) == expected;
+
+        // Update the counters
+        framesChecked.fetch_add(1, std::memory_order_relaxed);
+        if (!matches) {
+            fcsErrors.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return matches;
+    }
+
+    FrameCheckStatistics getFrameCheckStatistics() {
+        return {framesChecked.load(std::memory_order_relaxed), fcsErrors.load(std::memory_order_relaxed)};
+    }
+
+    void resetFrameCheckStatistics() {
+        framesChecked.store(0, std::memory_order_relaxed);
+        fcsErrors.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,30 @@
+/**
+ * @file frame_classifier.cpp
+ *
+ * @brief Implementation of the batch frame header validator and classifier
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Header Includes
+#include "frame_classifier.hpp"
+
+// Project Includes
+#include "frame_view.hpp"
+
+namespace EthernetDriverSimulation {
+
+    void classifyFrames(std::span<const FrameSegment> frames,
+                        std::span<ErrorCode> statuses,
+                        std::span<ExpectedPayloadData> types) {
+
+        // Parse each frame in place; the payload is never copied out of the rx buffer
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            FrameView frame;
+
+            statuses[i] = frame.parse(frames[i].data, frames[i].length);
+            types[i] = (ErrorCode::SUCCESS == statuses[i]) ? findFrameType(frame) : ExpectedPayloadData::UNKNOWN_PACKET;
+        }
+    }
+}
\ No newline at end of file
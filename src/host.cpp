@@ -18,6 +18,10 @@
 
 // Project Includes
 #include "ethernet_protocol.hpp"
+#include "fragment_header.hpp"
+#include "frame_classifier.hpp"
+#include "frame_header_schema.hpp"
+#include "frame_view.hpp"
 #include "video_codec.hpp"
 #include "ethernet_driver.hpp"
 
@@ -25,70 +29,214 @@ namespace EthernetDriverSimulation {
 
     Host::Host(EthernetDriver* driver, uint32_t address)
         : driver(driver), 
-          address(address) 
+          address(address),
+          videoReassembler([this](std::span<const uint8_t> data) {
+              encodedVideoFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+          })
     {
-        driver->registerReceiver(address, this);
+        // Allocate the rx buffer up front so receiving never allocates
+        for (RxBuffer* buffer : {&rxFilling, &rxProcessing}) {
+            buffer->slab = std::make_unique_for_overwrite<uint8_t[]>(RX_BUFFER_SIZE);
+            buffer->frames.reserve(MAX_PACKETS);
+        }
+        rxFrames.reserve(MAX_PACKETS);
+        rxFrameStatuses.reserve(MAX_PACKETS);
+        rxFrameTypes.reserve(MAX_PACKETS);
+
+        // Grant the driver one credit per frame the rx buffer holds
+        driver->registerReceiver(address, this, MAX_PACKETS);
     }    
 
     void Host::receiveFrame(const uint8_t *data, size_t size) {
-        // Put frame in rx buffer
-        std::array<uint8_t, EthernetFrame::MAX_FRAME_SIZE> frame;
-        std::memcpy(frame.data(), data, size);
-        rxBuffer.push_back(frame);
+        FrameRef frame = {data, size};
+        receiveFrames(std::span<const FrameRef>(&frame, 1));
     }
 
-    void Host::sendFrame(const std::vector<uint8_t>& payload) {
+    void Host::receiveFrames(std::span<const FrameRef> frames) {
 
         // Initialize method variables
-        std::array<uint8_t, 4> dest;
-        std::array<uint8_t, 4> source;
-        const uint8_t *dataPtr;  
+        std::size_t framesTaken = 0;
+        std::size_t bytesTaken = 0;
+
+        {
+            // The driver's worker delivers here while the owner may be swapping the buffers
+            std::lock_guard<std::mutex> lock(rxLock);
+            std::size_t slabOffset = rxFilling.slabUsed;
+            std::size_t firstFrame = rxFilling.frames.size();
+
+            // Take the frames the rx buffer has room for
+            while (framesTaken < frames.size() && slabOffset + bytesTaken + frames[framesTaken].size <= RX_BUFFER_SIZE) {
+                bytesTaken += frames[framesTaken].size;
+                framesTaken++;
+            }
 
-        // Convert dest
-        std::memcpy(dest.data(), &destinationAddress, 4);
+            // Grow the frame list once for the batch (within its reserved capacity), then copy in only the bytes on the wire
+            rxFilling.frames.resize(firstFrame + framesTaken);
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            uint64_t forwardedAt = LatencyClock::now();
+#endif
+            for (std::size_t i = 0; i < framesTaken; ++i) {
+                std::memcpy(rxFilling.slab.get() + slabOffset, frames[i].data, frames[i].size);
+                rxFilling.frames[firstFrame + i] = {slabOffset, frames[i].size};
+#if defined(EDS_LATENCY_HISTOGRAMS)
+                rxFilling.frames[firstFrame + i].forwardedAt = forwardedAt;
+#endif
+                slabOffset += frames[i].size;
+            }
+            rxFilling.slabUsed = slabOffset;
+        }
 
-        // Convert source
-        std::memcpy(source.data(), &address, 4);
+        if (framesTaken > 0) {
+            rxSignal.notify_one();
+        }
 
-        // Convert payload
-        dataPtr = payload.data();
+        // Drop the frames the rx buffer cannot hold, handing their credit straight back
+        if (framesTaken < frames.size()) {
+            driver->grantCredit(address, frames.size() - framesTaken);
+        }
+    }
 
-        // Construct Handshake packet
-        EthernetFrame frame(
-            dest,
-            source,
-            dataPtr,
-            payload.size()
-        ) ;
+    ErrorCode Host::sendFrame(const std::vector<uint8_t>& payload) {
 
-        std::size_t size = 0;
-        driver->storeSerializedFrame(frame.toHexStream(size));
+        // Initialize method variables
+        std::array<uint8_t, 4> dest = FrameHeaderSchema::addressToBytes(destinationAddress);
+        std::array<uint8_t, 4> source = FrameHeaderSchema::addressToBytes(address);
+        std::array<uint8_t, EthernetFrame::HEADER_SIZE> header;
+        std::array<uint8_t, EthernetFrame::FCS_SIZE> trailer;
+
+        // Check before narrowing: a length cast to 16 bits would wrap and frame only a prefix of the payload
+        if (payload.size() > EthernetFrame::MAX_PAYLOAD_SIZE) {
+            return ErrorCode::MALFORMED_FRAME;
+        }
+
+        // Frame the payload in place; only the header (and trailer) is serialized
+        if (frameCheckSequenceEnabled) {
+            return driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                trailer,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
+        else {
+            return driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
     }
 
-    ErrorCode Host::processReceivedFrames() {
+    ErrorCode Host::sendFrames(std::span<const std::span<const uint8_t>> payloads) {
+
+        // Initialize method variables
+        std::array<uint8_t, 4> dest = FrameHeaderSchema::addressToBytes(destinationAddress);
+        std::array<uint8_t, 4> source = FrameHeaderSchema::addressToBytes(address);
+        std::vector<FramePayload> batch;
+        std::size_t framesStored = 0;
+
+        // Describe each payload; the driver serializes the whole batch in one pass. A payload too
+        // large for a frame fails the batch here, before its length is narrowed to 16 bits
+        batch.reserve(payloads.size());
+        for (const auto& payload : payloads) {
+            if (payload.size() > EthernetFrame::MAX_PAYLOAD_SIZE) {
+                return ErrorCode::MALFORMED_FRAME;
+            }
+            batch.push_back({dest, source, payload.data(), static_cast<uint16_t>(payload.size()), frameCheckSequenceEnabled});
+        }
+
+        return driver->storeSerializedFrames(batch, framesStored);
+    }
+
+    void Host::sendControlFrame(ExpectedPayloadData data) {
 
         // Initialize method variables
-        bool started_video_processing = false; 
+        std::array<uint8_t, 4> dest = FrameHeaderSchema::addressToBytes(destinationAddress);
+        std::array<uint8_t, 4> source = FrameHeaderSchema::addressToBytes(address);
+        std::array<uint8_t, EthernetFrame::HEADER_SIZE> header;
+        std::array<uint8_t, EthernetFrame::FCS_SIZE> trailer;
+        std::array<uint8_t, CONTROL_PAYLOAD_SIZE> payload;
+        uint32_t rawData = static_cast<uint32_t>(data);
 
-        // Clear File
-        std::ofstream clearFile(ENCODED_FROM_DEVICE_VIDEO_FILE_PATH, std::ios::out | std::ios::trunc);
-        clearFile.close();
+        // The control payload lives on the stack; the driver copies the frame before this returns
+        for (std::size_t i = 0; i < CONTROL_PAYLOAD_SIZE; ++i) {
+            payload[i] = static_cast<uint8_t>((rawData >> (8 * i)) & 0xFF);
+        }
 
-        // Open File Handler
-        std::ofstream encodedFile(ENCODED_FROM_DEVICE_VIDEO_FILE_PATH, std::ios::out | std::ios::binary | std::ios::app);
+        if (frameCheckSequenceEnabled) {
+            driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                trailer,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
+        else {
+            driver->storeSerializedFrame(EthernetFrame::toSegments(
+                header,
+                dest,
+                source,
+                payload.data(),
+                static_cast<uint16_t>(payload.size())
+            ));
+        }
+    }
 
-        // Loop through all frames in the buffer
+    ErrorCode Host::processReceivedFrames() {
+
+        // Validate and classify every buffered frame header in one batch (scratch is reused between calls)
+        std::vector<FrameSegment>& frames = rxFrames;
+        std::vector<ErrorCode>& frameStatuses = rxFrameStatuses;
+        std::vector<ExpectedPayloadData>& frameTypes = rxFrameTypes;
+
+        // Take every frame received so far; the worker fills the emptied buffer meanwhile
+        {
+            std::lock_guard<std::mutex> lock(rxLock);
+            std::swap(rxFilling, rxProcessing);
+        }
+        const std::vector<ReceivedFrame>& rxBuffer = rxProcessing.frames;
+
+        frames.clear();
+        frameStatuses.resize(rxBuffer.size());
+        frameTypes.resize(rxBuffer.size());
+#if defined(EDS_LATENCY_HISTOGRAMS)
+        uint64_t processedAt = LatencyClock::now();
+#endif
         for (const auto& frame : rxBuffer) {
-            EthernetFrame currentFrame;
+            frames.push_back({rxProcessing.slab.get() + frame.offset, frame.length});
+#if defined(EDS_LATENCY_HISTOGRAMS)
+            driver->recordProcessLatency(processedAt - frame.forwardedAt);
+#endif
+        }
+
+        classifyFrames(frames, frameStatuses, frameTypes);
 
-            ErrorCode parseFrameStatus = currentFrame.fromHexSteam(frame.data());
+        // First failing frame's status; the frames after it are still processed
+        ErrorCode batchStatus = ErrorCode::SUCCESS;
+
+        // Loop through all frames in the buffer
+        for (std::size_t i = 0; i < rxBuffer.size(); ++i) {
+            // View the frame in place inside the rx buffer
+            FrameView currentFrame(frames[i].data);
+
+            ErrorCode parseFrameStatus = frameStatuses[i];
 
             if (ErrorCode::SUCCESS != parseFrameStatus)
             {
-                return parseFrameStatus;
+                std::cout << "DROPPED FRAME " << i << " OF BATCH: " << errorCodeToString(parseFrameStatus) << "\n";
+                if (ErrorCode::SUCCESS == batchStatus) {
+                    batchStatus = parseFrameStatus;
+                }
+                continue;
             }
 
-            ExpectedPayloadData packetType = findFrameType(currentFrame);
+            ExpectedPayloadData packetType = frameTypes[i];
 
             // If acknowledgement packet; display header and return
             if (packetType == ExpectedPayloadData::ACKNOWLEDGEMENT){
@@ -96,107 +244,161 @@ namespace EthernetDriverSimulation {
                 std::cout << currentFrame.frameHeaderToString() << "\n\n";
             }
 
-            // If video data; write to file
+            // If video data; reassemble the stream in order into the file
             if (packetType == ExpectedPayloadData::VIDEO_DATA){
-                started_video_processing = true; 
+                std::span<const uint8_t> payload = currentFrame.payload();
+                FragmentHeader fragment;
 
-                // Append Data of each 
-                encodedFile.write(reinterpret_cast<const char*>(currentFrame.payload.data()), currentFrame.payloadLength);
+                if (ErrorCode::SUCCESS != fragment.parse(payload)) {
+                    continue;
+                }
+
+                acceptVideoFragment(fragment, payload.subspan(FragmentHeader::SIZE));
             }
             
         }
 
-        // If video was received print out path to GIF file
-        if (started_video_processing)
-        {
-            // Close encoded file
-            encodedFile.close();
+        // Clear Buffer
+        releaseRxBuffer();
 
-            // Create Decoder Object
-            VideoCodec videoDecoder;
+        return batchStatus;
+    }
 
-            // Decode Video and save to file
-            videoDecoder.decodeH264ToGif(ENCODED_FROM_DEVICE_VIDEO_FILE_PATH, RECREATED_VIDEO_FILE_PATH);
+    void Host::acceptVideoFragment(const FragmentHeader& fragment, std::span<const uint8_t> data) {
 
-            // Output file path
-            std::cout << "Received and decoded video can be found out this path: " << RECREATED_VIDEO_FILE_PATH << "\n";
+        // A late or duplicate fragment of a stream already decoded must not reopen (and truncate) its file
+        if (videoStreamFinished && !FragmentHeader::isLaterStream(fragment.streamId, finishedVideoStreamId)) {
+            return;
+        }
+
+        // A newer stream means the rest of the current one is not coming; decode what arrived of it
+        if (videoStreamActive && fragment.streamId != videoStreamId) {
+            if (!FragmentHeader::isLaterStream(fragment.streamId, videoStreamId)) {
+                return;
+            }
 
-            // Reset the video processing variables
-            started_video_processing = false; 
+            ErrorCode flushStatus = videoReassembler.flush();
+            if (ErrorCode::SUCCESS != flushStatus) {
+                std::cout << "VIDEO STREAM " << videoStreamId << ": " << errorCodeToString(flushStatus) << "\n";
+            }
+            finishVideoStream();
         }
 
-        // Clear Buffer
-        clearRxBuffer();
+        // Start a new file with the first fragment of a stream
+        if (!videoStreamActive) {
+            encodedVideoFile.open(ENCODED_FROM_DEVICE_VIDEO_FILE_PATH, std::ios::out | std::ios::binary | std::ios::trunc);
+            videoStreamActive = true;
+            videoStreamId = fragment.streamId;
+        }
+
+        ErrorCode reassemblyStatus = videoReassembler.acceptFragment(fragment, data);
+        if (ErrorCode::SUCCESS != reassemblyStatus) {
+            std::cout << "VIDEO STREAM " << fragment.streamId << ": " << errorCodeToString(reassemblyStatus) << "\n";
+        }
 
-        return ErrorCode::SUCCESS;
+        // If the whole stream was received decode it
+        if (videoReassembler.isComplete()) {
+            finishVideoStream();
+        }
+    }
+
+    void Host::finishVideoStream() {
+        videoReassembler.reset();
+        videoStreamActive = false;
+        videoStreamFinished = true;
+        finishedVideoStreamId = videoStreamId;
+
+        // Close encoded file
+        encodedVideoFile.close();
+
+        // Create Decoder Object
+        VideoCodec videoDecoder;
+
+        // Decode Video and save to file
+        videoDecoder.decodeH264ToGif(ENCODED_FROM_DEVICE_VIDEO_FILE_PATH, RECREATED_VIDEO_FILE_PATH);
+
+        // Output file path
+        std::cout << "Received and decoded video can be found out this path: " << RECREATED_VIDEO_FILE_PATH << "\n";
     }
 
     void Host::performHandshake( void ) {
         // Set Payload
         ExpectedPayloadData data = ExpectedPayloadData::HANDSHAKE;
 
-        sendFrame(convertEnumToBytes(data));
+        sendControlFrame(data);
     }
 
     void Host::requestVideo( void ) {
         // Set Payload
         ExpectedPayloadData data = ExpectedPayloadData::VIDEO_REQUEST;
 
-        sendFrame(convertEnumToBytes(data));
+        sendControlFrame(data);
 
     }
 
     void Host::injectFrameError( InjectionType injectionType ) {
 
-        const uint8_t *dataPtr;
+        // Build a valid two byte frame, then corrupt the field under test
+        const uint8_t payload[] = {0x11, 0x22};
+        std::array<uint8_t, EthernetFrame::HEADER_SIZE + sizeof(payload)> frame;
+
+        FrameHeaderSchema::writeHeader(frame.data(),
+                                       FrameHeaderSchema::addressToBytes(destinationAddress),
+                                       FrameHeaderSchema::addressToBytes(address),
+                                       sizeof(payload), false);
+        std::memcpy(frame.data() + EthernetFrame::HEADER_SIZE, payload, sizeof(payload));
 
         if (injectionType == InjectionType::MALFORMED_PACKET) {
-            // Convert Data
-            uint8_t malformedFrame[] = {
-                0xDE, 0xAD, 0xBE, 0xEF,      // Destination
-                0x12, 0x34, 0x56, 0x78,      // Source
-                0xC0, 0xAF,                  //EtherType 
-                0x00, 0x02,                  // Payload Length (2 bytes)
-                0xBB, 0xBB,                  // [X] Delimiter 
-                0x11, 0x22                   // Payload (2 bytes)
-            };
-
-            dataPtr = malformedFrame;
+            FrameHeaderSchema::encode<FrameHeaderSchema::DELIMITER_FIELD>(frame.data(), 0xBBBB);
         } 
         else {
-            // Convert Data
-            uint8_t invalidEtherTypeFrame[] = {
-                0xDE, 0xAD, 0xBE, 0xEF,      // Destination
-                0x12, 0x34, 0x56, 0x78,      // Source
-                0x08, 0x00,                  // [X] EtherType 
-                0x00, 0x02,                  // Payload Length (2 bytes)
-                0xAB, 0xAB,                  // Delimiter 
-                0x11, 0x22                   // Payload (2 bytes)
-            };
+            FrameHeaderSchema::encode<FrameHeaderSchema::ETHER_TYPE_FIELD>(frame.data(), 0x0800);
+        }
+
+        const FrameSegment segment = {frame.data(), frame.size()};
+        driver->storeSerializedFrame(std::span<const FrameSegment>(&segment, 1));
+    }
+
+    void Host::clearRxBuffer() {
 
-            dataPtr = invalidEtherTypeFrame;
+        // Initialize method variables
+        std::size_t framesDropped = rxProcessing.frames.size();
+
+        // Empty both buffers before granting credit, so no frame the credit admits is wiped with them
+        {
+            std::lock_guard<std::mutex> lock(rxLock);
+            framesDropped += rxFilling.frames.size();
+            rxFilling.frames.clear();
+            rxFilling.slabUsed = 0;
         }
+        rxProcessing.frames.clear();
+        rxProcessing.slabUsed = 0;
 
-        std::size_t size = 0;
-        driver->storeSerializedFrame(dataPtr);
+        driver->grantCredit(address, framesDropped);
     }
 
-    const std::vector<uint8_t> Host::convertEnumToBytes(ExpectedPayloadData data) {
-        uint32_t rawData = static_cast<uint32_t>(data);
-        std::vector<uint8_t> bytes = {
-                                        static_cast<uint8_t>((rawData >> 0) & 0xFF),
-                                        static_cast<uint8_t>((rawData >> 8) & 0xFF),
-                                        static_cast<uint8_t>((rawData >> 16) & 0xFF),
-                                        static_cast<uint8_t>((rawData >> 24) & 0xFF)};
+    void Host::releaseRxBuffer() {
 
-        const std::vector<uint8_t>& refBytes = bytes;
+        // Initialize method variables
+        std::size_t framesConsumed = rxProcessing.frames.size();
+
+        // The processed batch's rx buffer space goes back to the driver as credit once it is empty
+        rxProcessing.frames.clear();
+        rxProcessing.slabUsed = 0;
+        driver->grantCredit(address, framesConsumed);
     }
 
-    void Host::clearRxBuffer() {
-        rxBuffer.clear();
+    bool Host::waitForReceivedFrames(std::chrono::milliseconds timeout) {
+        // Sleep until the driver delivers a frame (from its worker when one runs), or the timeout passes
+        std::unique_lock<std::mutex> lock(rxLock);
+        return rxSignal.wait_for(lock, timeout, [this] { return !rxFilling.frames.empty(); });
     }
 
     void Host::setDestinationAddress(uint32_t address) {
         destinationAddress = address;
     }
+
+    void Host::setFrameCheckSequence(bool enabled) {
+        frameCheckSequenceEnabled = enabled;
+    }
 }
@@ -0,0 +1,115 @@
+/**
+ * @file link_model.cpp
+ *
+ * @brief Implementation of the emulated link between the driver and a receiver
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Header Includes
+#include "link_model.hpp"
+
+// Standard Incudes
+#include <cmath>
+
+namespace EthernetDriverSimulation {
+
+    namespace {
+        // Raise an atomic to at least a value; returns the value it holds afterwards
+        uint64_t raiseTo(std::atomic<uint64_t>& value, uint64_t candidate) {
+            uint64_t current = value.load(std::memory_order_relaxed);
+            while (current < candidate && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+            }
+            return std::max(current, candidate);
+        }
+    }
+
+    LinkModel::LinkModel(const LinkParameters& parameters)
+        : parameters(parameters)
+    {
+    }
+
+    uint64_t LinkModel::schedule(std::size_t frameSize, uint64_t now, std::minstd_rand& random) {
+
+        // Initialize method variables
+        uint64_t wireTime = serializationTime(frameSize);
+        uint64_t freeAt = wireFreeAt.load(std::memory_order_relaxed);
+        uint64_t start = 0;
+
+        // Reserve the wire from when both the frame and the wire are ready
+        do {
+            start = std::max(freeAt, now);
+        } while (!wireFreeAt.compare_exchange_weak(freeAt, start + wireTime, std::memory_order_relaxed));
+
+        uint64_t unset = 0;
+        firstDeparture.compare_exchange_strong(unset, start, std::memory_order_relaxed);
+
+        // The last bit arrives one propagation delay (plus jitter) after it was sent, never before an earlier frame
+        int64_t delay = static_cast<int64_t>(parameters.propagationDelay.count()) + drawJitter(random);
+        uint64_t arrival = start + wireTime + static_cast<uint64_t>(std::max<int64_t>(delay, 0));
+        return raiseTo(lastArrival, arrival);
+    }
+
+    void LinkModel::countDelivered(std::size_t frameSize, std::size_t payloadSize, uint64_t arrival) {
+        framesDelivered.fetch_add(1, std::memory_order_relaxed);
+        payloadBytesDelivered.fetch_add(payloadSize, std::memory_order_relaxed);
+        wireBytesDelivered.fetch_add(frameSize + parameters.overheadBytes, std::memory_order_relaxed);
+        raiseTo(lastDelivered, arrival);
+    }
+
+    LinkStatistics LinkModel::getStatistics() const {
+
+        // Initialize method variables
+        LinkStatistics statistics;
+        uint64_t first = firstDeparture.load(std::memory_order_relaxed);
+        uint64_t last = lastDelivered.load(std::memory_order_relaxed);
+
+        statistics.configuredBitRate = parameters.bitRate;
+        statistics.framesDelivered = framesDelivered.load(std::memory_order_relaxed);
+        statistics.payloadBytesDelivered = payloadBytesDelivered.load(std::memory_order_relaxed);
+        statistics.wireBytesDelivered = wireBytesDelivered.load(std::memory_order_relaxed);
+
+        // Goodput is only defined once something went over the link
+        if (first == 0 || last <= first) {
+            return statistics;
+        }
+
+        statistics.elapsed = std::chrono::nanoseconds(last - first);
+        statistics.goodputBitsPerSecond = static_cast<double>(statistics.payloadBytesDelivered) * 8.0 * 1e9 / static_cast<double>(last - first);
+        if (parameters.bitRate != 0) {
+            statistics.goodputRatio = statistics.goodputBitsPerSecond / static_cast<double>(parameters.bitRate);
+        }
+
+        return statistics;
+    }
+
+    uint64_t LinkModel::serializationTime(std::size_t frameSize) const {
+        // An unlimited link puts the whole frame on the wire at once
+        if (parameters.bitRate == 0) {
+            return 0;
+        }
+
+        uint64_t bits = static_cast<uint64_t>(frameSize + parameters.overheadBytes) * 8;
+        return bits * 1000000000ull / parameters.bitRate;
+    }
+
+    int64_t LinkModel::drawJitter(std::minstd_rand& random) const {
+
+        // Initialize method variables
+        int64_t jitter = static_cast<int64_t>(parameters.jitter.count());
+
+        if (jitter <= 0) {
+            return 0;
+        }
+
+        switch (parameters.jitterDistribution) {
+            case JitterDistribution::UNIFORM:
+                return std::uniform_int_distribution<int64_t>(-jitter, jitter)(random);
+            case JitterDistribution::NORMAL:
+                return std::llround(std::normal_distribution<double>(0.0, static_cast<double>(jitter))(random));
+            default:
+                return 0;
+        }
+    }
+}
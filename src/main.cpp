@@ -8,6 +8,8 @@
  */
 
 //Standard Includes
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <iostream>
 
@@ -20,24 +22,52 @@
 
 using namespace EthernetDriverSimulation;
 
+// Simulated memory addresses (IP Address) for the Host and Device
+constexpr uint32_t HOST_ADDRESS   = 0x01020304;
+constexpr uint32_t DEVICE_ADDRESS = 0x0A0B0C0D;
+
+// How long a receiver waits for frames from the driver's service thread before giving up on a reply
+constexpr std::chrono::milliseconds SERVICE_THREAD_TIMEOUT(500);
+
+// Whether the driver's service thread forwards the frames instead of this thread
+bool serviceThreadRunning = false;
+
+/**
+ * @brief Forward the stored frames, waiting out the ones still travelling over an emulated link
+ */
+void forwardFrames(EthernetDriver& driver) {
+    do {
+        driver.processStoredFrame();
+    } while (driver.hasFramesInFlight());
+}
+
+/**
+ * @brief Deliver the stored frames and have the receiver process them; with the service thread
+ * running the receiver waits for the thread to deliver them instead of forwarding them itself
+ */
+template <typename Receiver>
+void deliverFrames(Receiver& receiver, EthernetDriver& driver) {
+    if (serviceThreadRunning) {
+        receiver.waitForReceivedFrames(SERVICE_THREAD_TIMEOUT);
+    }
+    else {
+        forwardFrames(driver);
+    }
+
+    receiver.processReceivedFrames();
+}
+
 void performHandshake(Host& host, EmbeddedDevice& device, EthernetDriver& driver) {
     std::cout << "\n--- Performing Handshake ---\n";
 
     // Call upon host to send handshake request
     host.performHandshake();
 
-    // Call upon ethernet driver to send frames
-    // TODO Frame -> Frames
-    driver.processStoredFrame();
-    
-    // Call upon device to read frames
-    device.processReceivedFrames();
+    // Call upon ethernet driver to send frames to the device, then upon the device to read them
+    deliverFrames(device, driver);
     
-    // Call upon ethernet driver to send frames
-    driver.processStoredFrame();
-
-    // Call upon host to read frames
-    host.processReceivedFrames();
+    // Call upon ethernet driver to send frames to the host, then upon the host to read them
+    deliverFrames(host, driver);
 
     std::cout << "\n--- Close Performing Handshake ---\n";
 };
@@ -70,44 +100,143 @@ void performInjectedError(Host& host, EmbeddedDevice& device, EthernetDriver& dr
     // Call upon host to send invalid packet
     host.injectFrameError(selectedType);
 
-    // Call upon ethernet driver to send frames
-    driver.processStoredFrame();
-    
-    // Call upon device to read frames
-    device.processReceivedFrames();
+    // Call upon ethernet driver to send frames to the device, then upon the device to read them
+    deliverFrames(device, driver);
     
-    // Call upon ethernet driver to send frames
-    driver.processStoredFrame();
-
-    // Call upon host to read frames
-    host.processReceivedFrames();
+    // Call upon ethernet driver to send frames to the host, then upon the host to read them
+    deliverFrames(host, driver);
     
     std::cout << "\n--- Ending Injected Error ---\n";
 }
 
+#if defined(EDS_LATENCY_HISTOGRAMS)
+void printLatency(const char* stage, const LatencyDistribution& latency) {
+    printf("%-20s samples %-10llu p50 %8llu ns  p99 %8llu ns  p99.9 %8llu ns  max %8llu ns\n",
+           stage,
+           static_cast<unsigned long long>(latency.samples),
+           static_cast<unsigned long long>(latency.percentile(0.5)),
+           static_cast<unsigned long long>(latency.percentile(0.99)),
+           static_cast<unsigned long long>(latency.percentile(0.999)),
+           static_cast<unsigned long long>(latency.maximum));
+}
+
+void printLatencies(const EthernetDriver& driver) {
+    DriverStatistics statistics;
+    driver.getStatistics(statistics);
+
+    std::cout << "\n--- Frame Latency ---\n";
+    printLatency("Store to forward:", statistics.forwardLatency);
+    printLatency("Forward to process:", statistics.processLatency);
+}
+#endif
+
 void performVideoCapture(Host& host, EmbeddedDevice& device, EthernetDriver& driver) {
     std::cout << "\n--- Video Capture Request ---\n";
 
     // Call upon host to send video request
     host.requestVideo();
 
-    // Call upon ethernet driver to send frames
-    // TODO Frame -> Frames
-    driver.processStoredFrame();
-    
-    // Call upon device to read frames
-    device.processReceivedFrames();
+    // Call upon ethernet driver to send frames to the device, then upon the device to read them
+    deliverFrames(device, driver);
     
-    // Call upon ethernet driver to send frames
-    driver.processStoredFrame();
+    // Keep forwarding and reading until the whole video went through the 7 frame buffers
+    if (serviceThreadRunning) {
+        // The service thread forwards; read whatever it delivers until nothing is left to send
+        while (host.waitForReceivedFrames(SERVICE_THREAD_TIMEOUT) || driver.hasStoredFrames()) {
+            host.processReceivedFrames();
+        }
+    }
+    else {
+        do {
+            // Call upon ethernet driver to send frames
+            driver.processStoredFrame();
+
+            // Call upon host to read frames (returning their credit to the driver)
+            host.processReceivedFrames();
+        } while (driver.hasStoredFrames());
+    }
+
+#if defined(EDS_LATENCY_HISTOGRAMS)
+    printLatencies(driver);
+#endif
 
-    // Call upon host to read frames
-    host.processReceivedFrames();
+    // Report how close the video came to the host's link rate
+    LinkStatistics linkStatistics;
+    if (ErrorCode::SUCCESS == driver.getLinkStatistics(HOST_ADDRESS, linkStatistics)) {
+        printf("\nLink to host: %llu frames, %llu payload bytes in %.3f ms, goodput %.2f Mbit/s of %.2f Mbit/s (%.1f%%)\n",
+               static_cast<unsigned long long>(linkStatistics.framesDelivered),
+               static_cast<unsigned long long>(linkStatistics.payloadBytesDelivered),
+               linkStatistics.elapsed.count() / 1e6,
+               linkStatistics.goodputBitsPerSecond / 1e6,
+               linkStatistics.configuredBitRate / 1e6,
+               linkStatistics.goodputRatio * 100.0);
+    }
 
     std::cout << "\n--- Ending Video Capture Request ---\n";
 
 }
 
+void configureLink(EthernetDriver& driver) {
+    std::cout << "\n--- Configure Link ---\n";
+    std::cout << "Choose link rate:\n";
+    std::cout << "1. 10 Mbit/s\n";
+    std::cout << "2. 100 Mbit/s\n";
+    std::cout << "3. 1000 Mbit/s\n";
+    std::cout << "Enter option: ";
+    int rateOption;
+    std::cin >> rateOption;
+
+    LinkParameters parameters;
+    
+    if (rateOption == 1) 
+    {
+        parameters.bitRate = 10000000;
+    } 
+    else if (rateOption == 2) 
+    {
+        parameters.bitRate = 100000000;
+    } 
+    else if (rateOption == 3) 
+    {
+        parameters.bitRate = 1000000000;
+    } 
+    else 
+    {
+        std::cout << "Invalid option.\n";
+        return;
+    }
+
+    long long propagationDelay = 0;
+    long long jitter = 0;
+    std::cout << "Enter propagation delay (microseconds): ";
+    std::cin >> propagationDelay;
+    std::cout << "Enter jitter, normally distributed (microseconds): ";
+    std::cin >> jitter;
+
+    parameters.propagationDelay = std::chrono::microseconds(std::max(propagationDelay, 0LL));
+    parameters.jitter = std::chrono::microseconds(std::max(jitter, 0LL));
+    parameters.jitterDistribution = JitterDistribution::NORMAL;
+
+    // The same link carries both directions
+    driver.setLink(HOST_ADDRESS, parameters);
+    driver.setLink(DEVICE_ADDRESS, parameters);
+
+    std::cout << "\n--- Link Configured ---\n";
+}
+
+void toggleServiceThread(EthernetDriver& driver) {
+    // Stopping the thread drains what it still holds; frames stored from then on are forwarded by this thread
+    if (serviceThreadRunning) {
+        driver.stopWorkers();
+    }
+    else {
+        driver.startServiceThread();
+    }
+    serviceThreadRunning = !serviceThreadRunning;
+
+    std::cout << "\n--- Service Thread " << (serviceThreadRunning ? "Started" : "Stopped") << " ---\n";
+}
+
 /**
  * @brief Main entry point of application
  * 
@@ -119,10 +248,6 @@ int main() {
     // Instantiate Ethernet Driver
     EthernetDriver driver;
 
-    // Simulated memory addresses (IP Address) for the Host and Device
-    constexpr uint32_t HOST_ADDRESS   = 0x01020304;
-    constexpr uint32_t DEVICE_ADDRESS = 0x0A0B0C0D;
-
     // Create Host and Device objects
     Host host(&driver, HOST_ADDRESS);
     EmbeddedDevice device(&driver, DEVICE_ADDRESS);
@@ -136,6 +261,8 @@ int main() {
         std::cout << "1. Perform Handshake\n";
         std::cout << "2. Injected Errors\n";
         std::cout << "3. Request Video Capture\n";
+        std::cout << "4. Configure Link\n";
+        std::cout << "5. Toggle Service Thread (" << (serviceThreadRunning ? "running" : "stopped") << ")\n";
         std::cout << "0. Exit\n";
         std::cout << "Choose an option: ";
 
@@ -152,8 +279,15 @@ int main() {
             case 3:
                 performVideoCapture(host, device, driver);
                 break;
+            case 4:
+                configureLink(driver);
+                break;
+            case 5:
+                toggleServiceThread(driver);
+                break;
             case 0:
                 std::cout << "Exiting...\n";
+                driver.stopWorkers();
                 return 0;
             default:
                 std::cout << "Invalid option.\n";
@@ -0,0 +1,337 @@
+/**
+ * @file shared_memory_transport.cpp
+ *
+ * @brief Implementation of the transport that carries frames between two processes through shared memory
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#if defined(__linux__)
+
+// Header Includes
+#include "shared_memory_transport.hpp"
+
+// Standard Incudes
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+// System Includes
+#include <fcntl.h>
+#include <signal.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Project Includes
+#include "frame_header_schema.hpp"
+
+namespace EthernetDriverSimulation {
+
+    namespace {
+        constexpr uint64_t REGION_MAGIC = 0x45445353484D3031ull;      // "EDSSHM01"
+
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+                      "futex words must be plain lock-free 32 bit atomics");
+
+        // Not FUTEX_PRIVATE_FLAG (nor std::atomic::wait): the word is shared with another process
+        long futex(std::atomic<uint32_t>& word, int operation, uint32_t value, const timespec *timeout) {
+            return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), operation, value, timeout, nullptr, 0);
+        }
+    }
+
+    SharedMemoryTransport::SharedMemoryTransport(EthernetDriver* driver)
+        : driver(driver)
+    {
+    }
+
+    SharedMemoryTransport::~SharedMemoryTransport() {
+        close();
+    }
+
+    ErrorCode SharedMemoryTransport::open(const std::string& name, Role role, uint32_t remoteAddress) {
+
+        // Initialize method variables
+        std::string path = (!name.empty() && name.front() == '/') ? name : "/" + name;
+        int flags = (role == Role::CREATE) ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR;
+        void *mapping = nullptr;
+        struct stat status = {};
+
+        if (region || name.empty()) {
+            return ErrorCode::INVALID_INPUT;
+        }
+
+        // A region left behind by an earlier creator may still be mapped by a stale peer: start from a new one
+        if (role == Role::CREATE) {
+            shm_unlink(path.c_str());
+        }
+
+        descriptor = shm_open(path.c_str(), flags, 0600);
+        if (descriptor < 0) {
+            return (role == Role::ATTACH && errno == ENOENT) ? ErrorCode::TRANSPORT_NOT_READY : ErrorCode::TRANSPORT_OPEN_FAILED;
+        }
+
+        // The creator sizes the region; an attacher only maps one of the size it was built for
+        ErrorCode result = ErrorCode::SUCCESS;
+        if (role == Role::CREATE) {
+            if (ftruncate(descriptor, sizeof(SharedRegion)) != 0) {
+                result = ErrorCode::TRANSPORT_OPEN_FAILED;
+            }
+        }
+        else if (fstat(descriptor, &status) != 0) {
+            result = ErrorCode::TRANSPORT_OPEN_FAILED;
+        }
+        else if (status.st_size != static_cast<off_t>(sizeof(SharedRegion))) {
+            result = (status.st_size == 0) ? ErrorCode::TRANSPORT_NOT_READY : ErrorCode::TRANSPORT_MISMATCH;
+        }
+
+        if (result == ErrorCode::SUCCESS) {
+            mapping = mmap(nullptr, sizeof(SharedRegion), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+            if (mapping == MAP_FAILED) {
+                result = ErrorCode::TRANSPORT_OPEN_FAILED;
+            }
+        }
+
+        if (result != ErrorCode::SUCCESS) {
+            ::close(descriptor);
+            descriptor = -1;
+            if (role == Role::CREATE) {
+                shm_unlink(path.c_str());
+            }
+            return result;
+        }
+
+        // Publish the region only once it is built; the attacher waits for the ready flag
+        if (role == Role::CREATE) {
+            region = new (mapping) SharedRegion();
+            region->magic = REGION_MAGIC;
+            region->regionSize = sizeof(SharedRegion);
+            region->creator = getpid();
+            region->ready.store(1, std::memory_order_release);
+        }
+        else {
+            region = static_cast<SharedRegion*>(mapping);
+            if (region->ready.load(std::memory_order_acquire) == 0) {
+                result = ErrorCode::TRANSPORT_NOT_READY;
+            }
+            else if (region->magic != REGION_MAGIC || region->regionSize != sizeof(SharedRegion)) {
+                result = ErrorCode::TRANSPORT_MISMATCH;
+            }
+            else if (kill(static_cast<pid_t>(region->creator), 0) != 0 && errno == ESRCH) {
+                // Its creator died without removing it; the new creator replaces it
+                result = ErrorCode::TRANSPORT_NOT_READY;
+            }
+
+            if (result != ErrorCode::SUCCESS) {
+                munmap(mapping, sizeof(SharedRegion));
+                region = nullptr;
+                ::close(descriptor);
+                descriptor = -1;
+                return result;
+            }
+        }
+
+        // The creator is side 0 and the attacher side 1 of every shared pair
+        std::size_t side = (role == Role::CREATE) ? 0 : 1;
+        outgoing = &region->rings[side];
+        incoming = &region->rings[1 - side];
+        local = &region->endpoints[side];
+        remote = &region->endpoints[1 - side];
+
+        regionName = path;
+        this->role = role;
+        this->remoteAddress = remoteAddress;
+        framesAccepted = 0;
+        creditedUpTo = RING_FRAMES;
+        driver->registerReceiver(remoteAddress, this, RING_FRAMES);
+
+        return ErrorCode::SUCCESS;
+    }
+
+    void SharedMemoryTransport::close() {
+        if (!region) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(sendLock);
+        if (role == Role::CREATE) {
+            region->ready.store(0, std::memory_order_release);
+            shm_unlink(regionName.c_str());
+        }
+        munmap(region, sizeof(SharedRegion));
+        ::close(descriptor);
+
+        region = nullptr;
+        descriptor = -1;
+        outgoing = incoming = nullptr;
+        local = remote = nullptr;
+    }
+
+    void SharedMemoryTransport::receiveFrame(const uint8_t* data, std::size_t size) {
+        FrameRef frame = {data, size};
+        receiveFrames(std::span<const FrameRef>(&frame, 1));
+    }
+
+    void SharedMemoryTransport::receiveFrames(std::span<const FrameRef> frames) {
+
+        // Initialize method variables
+        std::size_t framesFilled = 0;
+
+        std::lock_guard<std::mutex> lock(sendLock);
+        framesAccepted += frames.size();
+
+        // The driver only forwards with credit, so the ring has room; frames from the peer stay here
+        for (const FrameRef& frame : frames) {
+            if (!outgoing || frame.size > EthernetFrame::MAX_FRAME_SIZE || frame.size < FrameHeaderSchema::HEADER_SIZE ||
+                FrameHeaderSchema::decode<FrameHeaderSchema::SOURCE_ADDRESS_FIELD>(frame.data) == remoteAddress) {
+                continue;
+            }
+
+            auto& slot = outgoing->producerSlot(framesFilled++);
+            std::memcpy(slot.data.data(), frame.data, frame.size);
+            slot.length = frame.size;
+        }
+
+        if (framesFilled == 0) {
+            return;
+        }
+
+        // The whole batch becomes visible to the peer at once
+        outgoing->publish(framesFilled);
+        framesSent.add(framesFilled);
+
+        // Pairs with the fence in wait: either the peer sees the frames or we see it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (remote->sleeping.load(std::memory_order_relaxed) != 0) {
+            wake(*remote);
+        }
+    }
+
+    std::size_t SharedMemoryTransport::poll(std::size_t budget) {
+
+        // Initialize method variables
+        std::size_t consumed = 0;
+        std::size_t stored = 0;
+
+        if (!region) {
+            return 0;
+        }
+
+        std::size_t readable = std::min(incoming->readableSlots(), budget);
+        for (; consumed < readable; ++consumed) {
+            const auto& slot = incoming->consumerSlot(consumed);
+            if (slot.length > slot.data.size()) {
+                framesDropped.add(1);
+                continue;
+            }
+
+            // A full driver keeps the frame in the ring, which holds the peer back through its credit
+            ErrorCode result = driver->storeSerializedFrame(slot.data.data(), slot.length);
+            if (result == ErrorCode::ETHERNET_BUFFER_FULL) {
+                break;
+            }
+            if (result == ErrorCode::SUCCESS) {
+                stored++;
+            }
+            else {
+                framesDropped.add(1);
+            }
+        }
+
+        // Freed slots are the peer's credit; wake it if it sleeps waiting for them
+        if (consumed != 0) {
+            incoming->release(consumed);
+            framesReceived.add(stored);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (remote->sleeping.load(std::memory_order_relaxed) != 0) {
+                wake(*remote);
+            }
+        }
+
+        returnCredit();
+        return stored;
+    }
+
+    bool SharedMemoryTransport::wait(std::chrono::nanoseconds timeout) {
+        if (!region) {
+            return false;
+        }
+
+        // Read the doorbell before looking for work, so a ring after the check ends the wait at once
+        uint32_t seen = local->doorbell.load(std::memory_order_acquire);
+        local->sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (hasWork()) {
+            local->sleeping.store(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        timespec relative = {};
+        relative.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        relative.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        futex(local->doorbell, FUTEX_WAIT, seen, &relative);
+        systemCalls.fetch_add(1, std::memory_order_relaxed);
+
+        local->sleeping.store(0, std::memory_order_relaxed);
+        return hasWork();
+    }
+
+    TransportStatistics SharedMemoryTransport::getStatistics() const {
+
+        // Initialize method variables
+        TransportStatistics statistics;
+
+        statistics.framesSent = framesSent.read();
+        statistics.framesReceived = framesReceived.read();
+        statistics.framesDropped = framesDropped.read();
+        statistics.systemCalls = systemCalls.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    void SharedMemoryTransport::wake(Endpoint& endpoint) {
+        endpoint.doorbell.fetch_add(1, std::memory_order_release);
+        futex(endpoint.doorbell, FUTEX_WAKE, INT_MAX, nullptr);
+        systemCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t SharedMemoryTransport::returnCredit() {
+
+        // Initialize method variables
+        std::size_t credits = 0;
+
+        {
+            // The driver may use a credit for every free slot beyond the frames it already handed over
+            std::lock_guard<std::mutex> lock(sendLock);
+            std::size_t limit = framesAccepted + outgoing->writableSlots();
+            if (limit > creditedUpTo) {
+                credits = limit - creditedUpTo;
+                creditedUpTo = limit;
+            }
+        }
+
+        if (credits != 0) {
+            driver->grantCredit(remoteAddress, credits);
+        }
+        return credits;
+    }
+
+    bool SharedMemoryTransport::hasWork() {
+        if (incoming->readableSlots() != 0) {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(sendLock);
+        return framesAccepted + outgoing->writableSlots() > creditedUpTo;
+    }
+}
+
+#endif // __linux__
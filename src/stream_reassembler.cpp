@@ -0,0 +1,190 @@
+/**
+ * @file stream_reassembler.cpp
+ *
+ * @brief Implementation of the engine that rebuilds a fragmented stream in order
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Header Includes
+#include "stream_reassembler.hpp"
+
+// Standard Incudes
+#include <utility>
+
+namespace EthernetDriverSimulation {
+
+    StreamReassembler::StreamReassembler(DeliverCallback deliver)
+        : deliver(std::move(deliver))
+    {
+        // Allocate the window up front so holding a fragment never allocates
+        for (auto& held : window) {
+            held.data.reserve(FragmentHeader::MAX_DATA_SIZE);
+        }
+    }
+
+    ErrorCode StreamReassembler::acceptFragment(const FragmentHeader& header, std::span<const uint8_t> data) {
+
+        // A fragment of another stream starts reassembly over
+        if (!active || header.streamId != streamId) {
+            reset();
+            active = true;
+            streamId = header.streamId;
+        }
+
+        // Fragments already delivered (or after the end of the stream) are duplicates
+        if (complete || header.sequenceNumber < nextSequence) {
+            statistics.duplicateFragments++;
+            return ErrorCode::SUCCESS;
+        }
+
+        ErrorCode status = ErrorCode::SUCCESS;
+
+        // The window cannot hold this fragment; the oldest missing fragments are not coming
+        if (header.sequenceNumber - nextSequence >= REORDER_WINDOW) {
+            status = advanceTo(header.sequenceNumber - REORDER_WINDOW + 1);
+        }
+
+        // In order: deliver without copying, then release anything it unblocked
+        if (header.sequenceNumber == nextSequence) {
+            ErrorCode deliverStatus = deliverFragment(header.fragmentOffset, data, header.lastFragment);
+            nextSequence++;
+            ErrorCode drainStatus = drainWindow();
+
+            if (ErrorCode::SUCCESS != deliverStatus) {
+                status = deliverStatus;
+            }
+            if (ErrorCode::SUCCESS != drainStatus) {
+                status = drainStatus;
+            }
+            return status;
+        }
+
+        // Out of order: hold the fragment until the ones before it arrive
+        HeldFragment& held = window[header.sequenceNumber % REORDER_WINDOW];
+        if (held.occupied) {
+            statistics.duplicateFragments++;
+            return status;
+        }
+
+        held.occupied = true;
+        held.lastFragment = header.lastFragment;
+        held.sequenceNumber = header.sequenceNumber;
+        held.fragmentOffset = header.fragmentOffset;
+        held.data.assign(data.begin(), data.end());
+        statistics.fragmentsReordered++;
+
+        return status;
+    }
+
+    ErrorCode StreamReassembler::flush() {
+
+        // Nothing is outstanding
+        if (!active || complete) {
+            return ErrorCode::SUCCESS;
+        }
+
+        // Find the newest held fragment
+        bool anyHeld = false;
+        uint32_t newestSequence = nextSequence;
+        for (const auto& held : window) {
+            if (held.occupied && held.sequenceNumber >= newestSequence) {
+                newestSequence = held.sequenceNumber;
+                anyHeld = true;
+            }
+        }
+
+        // Deliver everything up to it, then end the stream
+        ErrorCode status = anyHeld ? advanceTo(newestSequence + 1) : ErrorCode::SUCCESS;
+        if (!complete) {
+            status = ErrorCode::FRAGMENT_GAP;
+        }
+
+        reset();
+        return status;
+    }
+
+    void StreamReassembler::reset() {
+        for (auto& held : window) {
+            held.occupied = false;
+        }
+
+        active = false;
+        complete = false;
+        streamId = 0;
+        nextSequence = 0;
+        nextOffset = 0;
+    }
+
+    ErrorCode StreamReassembler::deliverFragment(uint32_t fragmentOffset, std::span<const uint8_t> data, bool lastFragment) {
+
+        // Stream bytes between the previous fragment and this one are missing
+        ErrorCode status = (fragmentOffset == nextOffset) ? ErrorCode::SUCCESS : ErrorCode::FRAGMENT_GAP;
+
+        deliver(data);
+        nextOffset = static_cast<uint64_t>(fragmentOffset) + data.size();
+        complete = lastFragment;
+        statistics.fragmentsDelivered++;
+
+        return status;
+    }
+
+    ErrorCode StreamReassembler::advanceTo(uint32_t sequenceNumber) {
+
+        // Initialize method variables
+        ErrorCode status = ErrorCode::SUCCESS;
+        uint32_t windowEnd = (sequenceNumber - nextSequence > REORDER_WINDOW) ? nextSequence + REORDER_WINDOW : sequenceNumber;
+
+        // Deliver held fragments and skip missing ones until the window reaches the sequence number; only the
+        // next REORDER_WINDOW sequence numbers can be held, so walking further would find nothing
+        while (nextSequence < windowEnd && !complete) {
+            HeldFragment& held = window[nextSequence % REORDER_WINDOW];
+
+            if (held.occupied && held.sequenceNumber == nextSequence) {
+                if (ErrorCode::SUCCESS != deliverFragment(held.fragmentOffset, held.data, held.lastFragment)) {
+                    status = ErrorCode::FRAGMENT_GAP;
+                }
+                held.occupied = false;
+            }
+            else {
+                statistics.missingFragments++;
+                status = ErrorCode::FRAGMENT_GAP;
+            }
+
+            nextSequence++;
+        }
+
+        // A far jump (a long loss, or a corrupt sequence number without FCS) skips the rest in one step
+        if (nextSequence < sequenceNumber && !complete) {
+            statistics.missingFragments += sequenceNumber - nextSequence;
+            nextSequence = sequenceNumber;
+            status = ErrorCode::FRAGMENT_GAP;
+        }
+
+        ErrorCode drainStatus = drainWindow();
+        return (ErrorCode::SUCCESS != drainStatus) ? drainStatus : status;
+    }
+
+    ErrorCode StreamReassembler::drainWindow() {
+
+        // Initialize method variables
+        ErrorCode status = ErrorCode::SUCCESS;
+
+        // Deliver held fragments for as long as they continue the stream
+        while (!complete) {
+            HeldFragment& held = window[nextSequence % REORDER_WINDOW];
+            if (!held.occupied || held.sequenceNumber != nextSequence) {
+                break;
+            }
+
+            if (ErrorCode::SUCCESS != deliverFragment(held.fragmentOffset, held.data, held.lastFragment)) {
+                status = ErrorCode::FRAGMENT_GAP;
+            }
+            held.occupied = false;
+            nextSequence++;
+        }
+
+        return status;
+    }
+}
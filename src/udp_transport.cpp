@@ -0,0 +1,313 @@
+/**
+ * @file udp_transport.cpp
+ *
+ * @brief Implementation of the transport that carries frames between two processes over loopback UDP
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#if defined(__linux__)
+
+// Header Includes
+#include "udp_transport.hpp"
+
+// Standard Incudes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+// System Includes
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Project Includes
+#include "frame_header_schema.hpp"
+
+namespace EthernetDriverSimulation {
+
+    namespace {
+        sockaddr_in loopbackAddress(uint16_t port) {
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            return address;
+        }
+    }
+
+    void UdpTransport::Batch::allocate() {
+        frames.resize(BATCH_FRAMES);
+        vectors.resize(BATCH_FRAMES);
+        messages.assign(BATCH_FRAMES, mmsghdr{});
+
+        for (std::size_t i = 0; i < BATCH_FRAMES; ++i) {
+            vectors[i].iov_base = frames[i].data();
+            vectors[i].iov_len = frames[i].size();
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+
+    UdpTransport::UdpTransport(EthernetDriver* driver)
+        : driver(driver)
+    {
+        // Allocate both batches up front so moving frames never allocates
+        sendBatch.allocate();
+        receiveBatch.allocate();
+    }
+
+    UdpTransport::~UdpTransport() {
+        close();
+    }
+
+    ErrorCode UdpTransport::open(uint16_t localPort, uint16_t remotePort, uint32_t remoteAddress) {
+
+        // Initialize method variables
+        sockaddr_in localAddress = loopbackAddress(localPort);
+        sockaddr_in peerAddress = loopbackAddress(remotePort);
+        int bufferSize = SOCKET_BUFFER_SIZE;
+
+        if (socketDescriptor >= 0) {
+            return ErrorCode::INVALID_INPUT;
+        }
+
+        socketDescriptor = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (socketDescriptor < 0) {
+            return ErrorCode::TRANSPORT_OPEN_FAILED;
+        }
+
+        // Larger buffers only lower the loss when the peer falls behind; the kernel caps them, which is fine
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+
+        // Connected, the socket only takes datagrams from the peer's port
+        if (bind(socketDescriptor, reinterpret_cast<const sockaddr*>(&localAddress), sizeof(localAddress)) != 0 ||
+            connect(socketDescriptor, reinterpret_cast<const sockaddr*>(&peerAddress), sizeof(peerAddress)) != 0) {
+            ::close(socketDescriptor);
+            socketDescriptor = -1;
+            return ErrorCode::TRANSPORT_OPEN_FAILED;
+        }
+
+        this->remoteAddress = remoteAddress;
+        sendCount = 0;
+        receiveNext = 0;
+        receiveCount = 0;
+        driver->registerReceiver(remoteAddress, this, BATCH_FRAMES);
+
+        return ErrorCode::SUCCESS;
+    }
+
+    void UdpTransport::close() {
+        std::lock_guard<std::mutex> lock(sendLock);
+        if (socketDescriptor < 0) {
+            return;
+        }
+
+        // Frames already handed over still go out; what the socket has no room for is lost
+        sendBatched();
+        ::close(socketDescriptor);
+        socketDescriptor = -1;
+        sendCount = 0;
+        sendBlocked = false;
+    }
+
+    std::size_t UdpTransport::flush() {
+
+        // Initialize method variables
+        std::size_t released = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(sendLock);
+            if (socketDescriptor >= 0 && sendCount != 0) {
+                released = sendBatched();
+            }
+        }
+
+        if (released != 0) {
+            driver->grantCredit(remoteAddress, released);
+        }
+        return released;
+    }
+
+    void UdpTransport::receiveFrame(const uint8_t* data, std::size_t size) {
+        FrameRef frame = {data, size};
+        receiveFrames(std::span<const FrameRef>(&frame, 1));
+    }
+
+    void UdpTransport::receiveFrames(std::span<const FrameRef> frames) {
+
+        // Initialize method variables
+        std::size_t released = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(sendLock);
+
+            // The driver only forwards with credit, so the batch has room; frames from the peer stay here
+            for (const FrameRef& frame : frames) {
+                if (socketDescriptor < 0 || frame.size > EthernetFrame::MAX_FRAME_SIZE || frame.size < FrameHeaderSchema::HEADER_SIZE ||
+                    FrameHeaderSchema::decode<FrameHeaderSchema::SOURCE_ADDRESS_FIELD>(frame.data) == remoteAddress) {
+                    released++;
+                    continue;
+                }
+
+                std::memcpy(sendBatch.frames[sendCount].data(), frame.data, frame.size);
+                sendBatch.vectors[sendCount].iov_len = frame.size;
+                sendCount++;
+                if (sendCount == BATCH_FRAMES) {
+                    released += sendBatched();
+                }
+            }
+        }
+
+        if (released != 0) {
+            driver->grantCredit(remoteAddress, released);
+        }
+    }
+
+    std::size_t UdpTransport::poll(std::size_t budget) {
+
+        // Initialize method variables
+        std::size_t stored = 0;
+        bool socketDrained = false;
+
+        if (socketDescriptor < 0) {
+            return 0;
+        }
+
+        while (stored < budget) {
+
+            // Only ask the socket again when the last batch came back full
+            if (receiveNext == receiveCount) {
+                if (socketDrained) {
+                    break;
+                }
+
+                unsigned int requested = static_cast<unsigned int>(std::min(BATCH_FRAMES, budget - stored));
+                int result = recvmmsg(socketDescriptor, receiveBatch.messages.data(), requested, MSG_DONTWAIT, nullptr);
+                systemCalls.fetch_add(1, std::memory_order_relaxed);
+                if (result <= 0) {
+                    break;
+                }
+
+                receiveNext = 0;
+                receiveCount = static_cast<std::size_t>(result);
+                socketDrained = (receiveCount < requested);
+            }
+
+            // A full driver keeps the datagram here until the next poll
+            const mmsghdr& message = receiveBatch.messages[receiveNext];
+            if ((message.msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+                framesDropped.fetch_add(1, std::memory_order_relaxed);
+                receiveNext++;
+                continue;
+            }
+
+            ErrorCode result = driver->storeSerializedFrame(receiveBatch.frames[receiveNext].data(), message.msg_len);
+            if (result == ErrorCode::ETHERNET_BUFFER_FULL) {
+                break;
+            }
+            if (result == ErrorCode::SUCCESS) {
+                stored++;
+            }
+            else {
+                framesDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            receiveNext++;
+        }
+
+        framesReceived.add(stored);
+        flush();
+        return stored;
+    }
+
+    bool UdpTransport::wait(std::chrono::nanoseconds timeout) {
+        if (socketDescriptor < 0) {
+            return false;
+        }
+
+        // Initialize method variables
+        short events = POLLIN;
+
+        // Datagrams held back by a full driver and frames batched but not yet sent are work already
+        if (receiveNext != receiveCount) {
+            return true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sendLock);
+            if (sendCount != 0 && !sendBlocked) {
+                return true;
+            }
+
+            // Frames the socket had no room for: sleep until it drains instead of retrying the send in a loop
+            if (sendCount != 0) {
+                events |= POLLOUT;
+            }
+        }
+
+        pollfd descriptor = {socketDescriptor, events, 0};
+        timespec relative = {};
+        relative.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        relative.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        int result = ppoll(&descriptor, 1, &relative, nullptr);
+        systemCalls.fetch_add(1, std::memory_order_relaxed);
+
+        return result > 0;
+    }
+
+    TransportStatistics UdpTransport::getStatistics() const {
+
+        // Initialize method variables
+        TransportStatistics statistics;
+
+        statistics.framesSent = framesSent.read();
+        statistics.framesReceived = framesReceived.read();
+        statistics.framesDropped = framesDropped.load(std::memory_order_relaxed);
+        statistics.systemCalls = systemCalls.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    std::size_t UdpTransport::sendBatched() {
+
+        // Initialize method variables
+        std::size_t released = 0;
+
+        sendBlocked = false;
+        while (released < sendCount) {
+            int result = sendmmsg(socketDescriptor, &sendBatch.messages[released], static_cast<unsigned int>(sendCount - released), MSG_DONTWAIT);
+            systemCalls.fetch_add(1, std::memory_order_relaxed);
+
+            if (result >= 0) {
+                framesSent.add(static_cast<uint64_t>(result));
+                released += static_cast<std::size_t>(result);
+                continue;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+                sendBlocked = true;
+                break;
+            }
+
+            // The peer is not listening (ECONNREFUSED) or the socket failed: the frame at the front is lost
+            framesDropped.fetch_add(1, std::memory_order_relaxed);
+            released++;
+        }
+
+        // Move what the socket had no room for to the front of the batch, for the next flush
+        for (std::size_t i = released; i < sendCount; ++i) {
+            std::memcpy(sendBatch.frames[i - released].data(), sendBatch.frames[i].data(), sendBatch.vectors[i].iov_len);
+            sendBatch.vectors[i - released].iov_len = sendBatch.vectors[i].iov_len;
+        }
+        sendCount -= released;
+
+        return released;
+    }
+}
+
+#endif // __linux__
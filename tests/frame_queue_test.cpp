@@ -0,0 +1,166 @@
+/**
+ * @file frame_queue_test.cpp
+ *
+ * @brief Unit tests of the bounded multi producer / single consumer frame queue
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Project Includes
+#include "frame_queue.hpp"
+#include "test_support.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr std::size_t CAPACITY = 8;
+    using TestQueue = FrameQueue<8, CAPACITY>;
+
+    void writeTag(TestQueue::FrameSlot& slot, uint32_t producer, uint32_t index) {
+        std::memcpy(slot.data.data(), &producer, sizeof(producer));
+        std::memcpy(slot.data.data() + sizeof(producer), &index, sizeof(index));
+        slot.length = sizeof(producer) + sizeof(index);
+    }
+
+    void readTag(const TestQueue::FrameSlot& slot, uint32_t& producer, uint32_t& index) {
+        std::memcpy(&producer, slot.data.data(), sizeof(producer));
+        std::memcpy(&index, slot.data.data() + sizeof(producer), sizeof(index));
+    }
+
+    void claimedSlotsAreInvisibleUntilPublished() {
+        TestQueue queue;
+        std::size_t position = 0;
+
+        EDS_CHECK(nullptr == queue.front());
+        EDS_CHECK(3 == queue.claim(3, position));
+        EDS_CHECK(0 == position);
+        for (std::size_t i = 0; i < 3; ++i) {
+            writeTag(queue.slotAt(position + i), 0, static_cast<uint32_t>(i));
+        }
+        EDS_CHECK(nullptr == queue.front());
+        EDS_CHECK(0 == queue.readable(CAPACITY));
+
+        queue.publish(position, 3);
+        EDS_CHECK(3 == queue.readable(CAPACITY));
+        EDS_CHECK(2 == queue.readable(2));
+        EDS_CHECK(nullptr != queue.peek(2));
+        EDS_CHECK(nullptr == queue.peek(3));
+
+        uint32_t producer = 0;
+        uint32_t index = 0;
+        readTag(*queue.front(), producer, index);
+        EDS_CHECK(0 == index);
+        queue.pop();
+        readTag(*queue.front(), producer, index);
+        EDS_CHECK(1 == index);
+    }
+
+    void aFullQueueRefusesClaimsUntilTheConsumerPops() {
+        TestQueue queue;
+        std::size_t position = 0;
+
+        // A claim larger than the queue is cut to the free slots
+        EDS_CHECK(CAPACITY == queue.claim(CAPACITY + 4, position));
+        queue.publish(position, CAPACITY);
+        EDS_CHECK(queue.full());
+        EDS_CHECK(0 == queue.claim(1, position));
+
+        queue.pop(2);
+        EDS_CHECK(!queue.full());
+        EDS_CHECK(2 == queue.claim(4, position));
+        EDS_CHECK(CAPACITY == position);
+        EDS_CHECK(0 == queue.claim(1, position));
+    }
+
+    void slotsAreReusedLapAfterLap() {
+        TestQueue queue;
+        uint32_t producer = 0;
+        uint32_t index = 0;
+
+        for (uint32_t i = 0; i < CAPACITY * 5; ++i) {
+            std::size_t position = 0;
+            EDS_CHECK(1 == queue.claim(1, position));
+            writeTag(queue.slotAt(position), 0, i);
+            queue.publish(position, 1);
+
+            readTag(*queue.front(), producer, index);
+            EDS_CHECK(i == index);
+            queue.pop();
+        }
+        EDS_CHECK(nullptr == queue.front());
+    }
+
+    void concurrentProducersKeepTheirOwnOrder() {
+        constexpr uint32_t PRODUCERS = 4;
+        constexpr uint32_t FRAMES = 20000;
+        TestQueue queue;
+        std::vector<std::thread> producers;
+        std::array<uint32_t, PRODUCERS> nextIndex = {};
+        std::size_t received = 0;
+        bool ordered = true;
+
+        // Each producer claims batches of 1 to 3 slots and tags every frame with its own running index
+        for (uint32_t producer = 0; producer < PRODUCERS; ++producer) {
+            producers.emplace_back([&queue, producer] {
+                uint32_t index = 0;
+                while (index < FRAMES) {
+                    std::size_t position = 0;
+                    std::size_t wanted = std::min<std::size_t>(1 + index % 3, FRAMES - index);
+                    std::size_t claimed = queue.claim(wanted, position);
+                    if (claimed == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (std::size_t i = 0; i < claimed; ++i) {
+                        writeTag(queue.slotAt(position + i), producer, index++);
+                    }
+                    queue.publish(position, claimed);
+                }
+            });
+        }
+
+        // One consumer: every producer's frames must come out exactly once and in the order it queued them
+        while (received < PRODUCERS * FRAMES) {
+            const TestQueue::FrameSlot *slot = queue.front();
+            if (nullptr == slot) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint32_t producer = 0;
+            uint32_t index = 0;
+            readTag(*slot, producer, index);
+            if (producer >= PRODUCERS || index != nextIndex[producer]) {
+                ordered = false;
+                break;
+            }
+            nextIndex[producer]++;
+            received++;
+            queue.pop();
+        }
+
+        for (std::thread& thread : producers) {
+            thread.join();
+        }
+        EDS_CHECK(ordered);
+        EDS_CHECK(PRODUCERS * FRAMES == received);
+        EDS_CHECK(nullptr == queue.front());
+    }
+}
+
+int main() {
+    claimedSlotsAreInvisibleUntilPublished();
+    aFullQueueRefusesClaimsUntilTheConsumerPops();
+    slotsAreReusedLapAfterLap();
+    concurrentProducersKeepTheirOwnOrder();
+
+    return Test::finish("frame_queue");
+}
@@ -0,0 +1,218 @@
+/**
+ * @file stream_reassembler_test.cpp
+ *
+ * @brief Unit tests of in order reassembly of out of order, duplicated and lost fragments
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <initializer_list>
+#include <vector>
+
+// Project Includes
+#include "stream_reassembler.hpp"
+#include "test_support.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+    constexpr std::size_t FRAGMENT_SIZE = 4;
+
+    /**
+     * @brief A stream of fragmentCount fragments whose bytes name their position, and a reassembler writing into memory
+     */
+    class Stream {
+        public:
+            explicit Stream(uint32_t fragmentCount, uint16_t streamId = 1)
+                : fragmentCount(fragmentCount),
+                  streamId(streamId),
+                  reassembler([this](std::span<const uint8_t> data) { received.insert(received.end(), data.begin(), data.end()); })
+            {
+                for (std::size_t i = 0; i < fragmentCount * FRAGMENT_SIZE; ++i) {
+                    bytes.push_back(static_cast<uint8_t>(i));
+                }
+            }
+
+            ErrorCode send(uint32_t sequence, uint16_t id) {
+                FragmentHeader header;
+                header.streamId = id;
+                header.sequenceNumber = sequence;
+                header.fragmentOffset = static_cast<uint32_t>(sequence * FRAGMENT_SIZE);
+                header.lastFragment = (sequence + 1 == fragmentCount);
+                return reassembler.acceptFragment(header, std::span<const uint8_t>(bytes).subspan(sequence * FRAGMENT_SIZE, FRAGMENT_SIZE));
+            }
+
+            ErrorCode send(uint32_t sequence) {
+                return send(sequence, streamId);
+            }
+
+            // The stream bytes of the given fragments, in the order listed
+            std::vector<uint8_t> expected(std::initializer_list<uint32_t> sequences) const {
+                std::vector<uint8_t> result;
+                for (uint32_t sequence : sequences) {
+                    result.insert(result.end(), bytes.begin() + sequence * FRAGMENT_SIZE, bytes.begin() + (sequence + 1) * FRAGMENT_SIZE);
+                }
+                return result;
+            }
+
+            uint32_t fragmentCount;
+            uint16_t streamId;
+            std::vector<uint8_t> bytes;
+            std::vector<uint8_t> received;
+            StreamReassembler reassembler;
+    };
+
+    void inOrderFragmentsAreDeliveredStraightAway() {
+        Stream stream(3);
+
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(0));
+        EDS_CHECK(stream.received == stream.expected({0}));
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(1));
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(2));
+        EDS_CHECK(stream.received == stream.bytes);
+        EDS_CHECK(stream.reassembler.isComplete());
+        EDS_CHECK(3 == stream.reassembler.getStatistics().fragmentsDelivered);
+        EDS_CHECK(0 == stream.reassembler.getStatistics().fragmentsReordered);
+    }
+
+    void outOfOrderFragmentsAreHeldUntilTheGapFills() {
+        Stream stream(5);
+
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(2));
+        EDS_CHECK(stream.received.empty());
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(0));
+        EDS_CHECK(stream.received == stream.expected({0}));
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(1));
+        EDS_CHECK(stream.received == stream.expected({0, 1, 2}));
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(4));
+        EDS_CHECK(!stream.reassembler.isComplete());
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(3));
+        EDS_CHECK(stream.received == stream.bytes);
+        EDS_CHECK(stream.reassembler.isComplete());
+        EDS_CHECK(2 == stream.reassembler.getStatistics().fragmentsReordered);
+        EDS_CHECK(0 == stream.reassembler.getStatistics().missingFragments);
+    }
+
+    void duplicateFragmentsAreCountedAndDropped() {
+        Stream stream(3);
+
+        stream.send(0);
+        stream.send(0);     // Already delivered
+        stream.send(2);
+        stream.send(2);     // Already held
+        stream.send(1);
+        stream.send(1);     // After the end of the stream
+        EDS_CHECK(stream.received == stream.bytes);
+        EDS_CHECK(stream.reassembler.isComplete());
+        EDS_CHECK(3 == stream.reassembler.getStatistics().duplicateFragments);
+        EDS_CHECK(3 == stream.reassembler.getStatistics().fragmentsDelivered);
+    }
+
+    void windowOverflowSkipsTheMissingFragment() {
+        constexpr uint32_t FRAGMENTS = StreamReassembler::REORDER_WINDOW + 8;
+        Stream stream(FRAGMENTS);
+        std::vector<uint8_t> expected = stream.expected({0});
+
+        // Fragment 1 is lost: the window fills with 2 .. REORDER_WINDOW before anything after 0 is delivered
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(0));
+        for (uint32_t sequence = 2; sequence <= StreamReassembler::REORDER_WINDOW; ++sequence) {
+            EDS_CHECK(ErrorCode::SUCCESS == stream.send(sequence));
+        }
+        EDS_CHECK(stream.received == expected);
+
+        // The first fragment that does not fit gives fragment 1 up and releases the window
+        EDS_CHECK(ErrorCode::FRAGMENT_GAP == stream.send(StreamReassembler::REORDER_WINDOW + 1));
+        EDS_CHECK(1 == stream.reassembler.getStatistics().missingFragments);
+        for (uint32_t sequence = StreamReassembler::REORDER_WINDOW + 2; sequence < FRAGMENTS; ++sequence) {
+            EDS_CHECK(ErrorCode::SUCCESS == stream.send(sequence));
+        }
+        for (uint32_t sequence = 2; sequence < FRAGMENTS; ++sequence) {
+            std::vector<uint8_t> fragment = stream.expected({sequence});
+            expected.insert(expected.end(), fragment.begin(), fragment.end());
+        }
+        EDS_CHECK(stream.received == expected);
+        EDS_CHECK(stream.reassembler.isComplete());
+        EDS_CHECK(FRAGMENTS - 1 == stream.reassembler.getStatistics().fragmentsDelivered);
+    }
+
+    void aHugeSequenceJumpSkipsTheGapInOneStep() {
+        Stream stream(4);
+        FragmentHeader corrupt;
+        const std::vector<uint8_t> data(FRAGMENT_SIZE, 0xEE);
+
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(0));
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(2));
+
+        // A corrupt sequence number far ahead releases the held fragment and skips everything before it
+        corrupt.streamId = stream.streamId;
+        corrupt.sequenceNumber = 0xFFFFFFFF;
+        corrupt.fragmentOffset = 0;
+        corrupt.lastFragment = false;
+        EDS_CHECK(ErrorCode::FRAGMENT_GAP == stream.reassembler.acceptFragment(corrupt, data));
+        EDS_CHECK(stream.received == stream.expected({0, 2}));
+
+        // Every sequence number below the new window but fragment 2 was skipped
+        uint64_t windowStart = 0xFFFFFFFFull - StreamReassembler::REORDER_WINDOW + 1;
+        EDS_CHECK(windowStart - 2 == stream.reassembler.getStatistics().missingFragments);
+
+        // A skipped fragment turning up late is behind the stream now
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(1));
+        EDS_CHECK(1 == stream.reassembler.getStatistics().duplicateFragments);
+        EDS_CHECK(stream.received == stream.expected({0, 2}));
+    }
+
+    void flushDeliversHeldFragmentsOfAStreamThatStopped() {
+        Stream stream(4);
+
+        // Fragment 1 and the last fragment are lost
+        stream.send(0);
+        stream.send(2);
+        EDS_CHECK(stream.received == stream.expected({0}));
+        EDS_CHECK(ErrorCode::FRAGMENT_GAP == stream.reassembler.flush());
+        EDS_CHECK(stream.received == stream.expected({0, 2}));
+        EDS_CHECK(1 == stream.reassembler.getStatistics().missingFragments);
+
+        // Nothing is outstanding any more
+        EDS_CHECK(ErrorCode::SUCCESS == stream.reassembler.flush());
+    }
+
+    void aNewStreamRestartsReassembly() {
+        Stream stream(3, 7);
+
+        stream.send(0);
+        stream.send(2);
+        stream.received.clear();
+
+        // The held fragment of stream 7 must not leak into stream 8
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(0, 8));
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(1, 8));
+        EDS_CHECK(stream.received == stream.expected({0, 1}));
+        EDS_CHECK(!stream.reassembler.isComplete());
+        EDS_CHECK(ErrorCode::SUCCESS == stream.send(2, 8));
+        EDS_CHECK(stream.received == stream.bytes);
+        EDS_CHECK(stream.reassembler.isComplete());
+    }
+
+    void streamIdsCompareAcrossTheWrap() {
+        EDS_CHECK(FragmentHeader::isLaterStream(1, 0));
+        EDS_CHECK(!FragmentHeader::isLaterStream(0, 0));
+        EDS_CHECK(!FragmentHeader::isLaterStream(0, 1));
+        EDS_CHECK(FragmentHeader::isLaterStream(0, 0xFFFF));
+        EDS_CHECK(!FragmentHeader::isLaterStream(0xFFFF, 0));
+    }
+}
+
+int main() {
+    inOrderFragmentsAreDeliveredStraightAway();
+    outOfOrderFragmentsAreHeldUntilTheGapFills();
+    duplicateFragmentsAreCountedAndDropped();
+    windowOverflowSkipsTheMissingFragment();
+    aHugeSequenceJumpSkipsTheGapInOneStep();
+    flushDeliversHeldFragmentsOfAStreamThatStopped();
+    aNewStreamRestartsReassembly();
+    streamIdsCompareAcrossTheWrap();
+
+    return Test::finish("stream_reassembler");
+}
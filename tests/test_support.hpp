@@ -0,0 +1,44 @@
+/**
+ * @file test_support.hpp
+ *
+ * @brief Check and reporting helpers shared by the unit tests
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+#ifndef EDS_TEST_SUPPORT_HPP__
+#define EDS_TEST_SUPPORT_HPP__
+
+// Standard Includes
+#include <cstdio>
+
+// Declare namespace
+namespace EthernetDriverSimulation::Test
+{
+    inline int failures = 0;
+
+    /**
+     * @brief Record one check, printing where it failed
+     */
+    inline void check(bool passed, const char* expression, const char* file, int line) {
+        if (!passed) {
+            std::printf("%s:%d: check failed: %s\n", file, line, expression);
+            failures++;
+        }
+    }
+
+    /**
+     * @brief Print the test's result line
+     *
+     * @return int: process exit status, non zero when a check failed
+     */
+    inline int finish(const char* test) {
+        std::printf("%-24s %s (%d failed checks)\n", test, (failures == 0) ? "passed" : "FAILED", failures);
+        return (failures == 0) ? 0 : 1;
+    }
+};
+
+#define EDS_CHECK(expression) EthernetDriverSimulation::Test::check((expression), #expression, __FILE__, __LINE__)
+
+#endif // EDS_TEST_SUPPORT_HPP__
@@ -0,0 +1,209 @@
+/**
+ * @file timing_wheel_test.cpp
+ *
+ * @brief Unit tests of timer expiry across the wheel's levels, cancellation and rescheduling
+ *
+ * @author Bryce Schmisseur
+ *
+ */
+
+// Standard Includes
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Project Includes
+#include "test_support.hpp"
+#include "timing_wheel.hpp"
+
+using namespace EthernetDriverSimulation;
+
+namespace {
+
+    // Run every timer due by a time, as the driver's service loop does
+    void expireUntil(TimingWheel& wheel, uint64_t now) {
+        TimingWheel::Callback callback;
+        while (wheel.expire(now, callback)) {
+            callback();
+        }
+    }
+
+    void timersFireOnTheirTickAndNeverEarly() {
+        TimingWheel wheel(100, 0);
+        std::vector<uint64_t> fired;
+
+        wheel.schedule(250, [&] { fired.push_back(250); });     // Rounded up to tick 3
+        wheel.schedule(100, [&] { fired.push_back(100); });
+
+        expireUntil(wheel, 99);
+        EDS_CHECK(fired.empty());
+        expireUntil(wheel, 100);
+        EDS_CHECK(fired == std::vector<uint64_t>({100}));
+        expireUntil(wheel, 299);
+        EDS_CHECK(fired.size() == 1);
+        expireUntil(wheel, 300);
+        EDS_CHECK(fired == std::vector<uint64_t>({100, 250}));
+        EDS_CHECK(0 == wheel.size());
+        EDS_CHECK(TimingWheel::NEVER == wheel.nextExpiry());
+    }
+
+    void timersCascadeAcrossLevelBoundaries() {
+        // One nanosecond ticks: level 0 spans 256 ticks, level 1 65536, level 2 2^24, and so on
+        const std::vector<uint64_t> expiries = {
+            1, 255, 256, 257, 511, 512, 65535, 65536, 65537, 70000,
+            (uint64_t{1} << 24) - 1, uint64_t{1} << 24, (uint64_t{1} << 24) + 300,
+            (uint64_t{1} << 32) + 5, (uint64_t{1} << 40) + (uint64_t{1} << 16) + 1
+        };
+        TimingWheel wheel(1, 0);
+        std::vector<uint64_t> fired;
+        bool onTime = true;
+        uint64_t now = 0;
+
+        for (uint64_t expiry : expiries) {
+            wheel.schedule(expiry, [&, expiry] {
+                fired.push_back(expiry);
+                onTime = onTime && (expiry == now);
+            });
+        }
+
+        // Advance one expiry at a time: each timer fires exactly on its tick, after those before it
+        for (uint64_t expiry : expiries) {
+            EDS_CHECK(wheel.nextExpiry() <= expiry);
+            now = expiry - 1;
+            expireUntil(wheel, now);
+            now = expiry;
+            expireUntil(wheel, now);
+        }
+        EDS_CHECK(onTime);
+        EDS_CHECK(fired == expiries);
+        EDS_CHECK(0 == wheel.size());
+    }
+
+    void aLargeStepFiresEveryTimerInExpiryOrder() {
+        TimingWheel wheel(1, 1000);
+        std::vector<uint64_t> fired;
+
+        for (uint64_t expiry : {uint64_t{1} << 33, uint64_t{70000}, uint64_t{1300}, uint64_t{1} << 20}) {
+            wheel.schedule(expiry, [&fired, expiry] { fired.push_back(expiry); });
+        }
+
+        expireUntil(wheel, uint64_t{1} << 34);
+        EDS_CHECK(fired == std::vector<uint64_t>({1300, 70000, uint64_t{1} << 20, uint64_t{1} << 33}));
+    }
+
+    void cancelledTimersNeverFire() {
+        TimingWheel wheel(1, 0);
+        std::vector<uint64_t> fired;
+
+        TimingWheel::TimerId near = wheel.schedule(10, [&] { fired.push_back(10); });
+        TimingWheel::TimerId far = wheel.schedule(100000, [&] { fired.push_back(100000); });
+        wheel.schedule(300, [&] { fired.push_back(300); });
+
+        EDS_CHECK(wheel.cancel(near));
+        EDS_CHECK(!wheel.cancel(near));
+        EDS_CHECK(2 == wheel.size());
+
+        // Cancelled from a higher level after the wheel cascaded past its first boundary
+        expireUntil(wheel, 70000);
+        EDS_CHECK(wheel.cancel(far));
+        expireUntil(wheel, 200000);
+        EDS_CHECK(fired == std::vector<uint64_t>({300}));
+
+        // Fired timers cannot be cancelled; a reused timer is not reachable through the old id
+        TimingWheel::TimerId reused = wheel.schedule(300000, [&] { fired.push_back(300000); });
+        EDS_CHECK(!wheel.cancel(near));
+        EDS_CHECK(!wheel.reschedule(far, 400000));
+        EDS_CHECK(1 == wheel.size());
+        EDS_CHECK(wheel.cancel(reused));
+        EDS_CHECK(0 == wheel.size());
+    }
+
+    void rescheduledTimersMoveBetweenLevels() {
+        TimingWheel wheel(1, 0);
+        std::vector<uint64_t> fired;
+
+        TimingWheel::TimerId earlier = wheel.schedule(1 << 20, [&] { fired.push_back(1); });
+        TimingWheel::TimerId later = wheel.schedule(5, [&] { fired.push_back(2); });
+
+        EDS_CHECK(wheel.reschedule(earlier, 100));
+        EDS_CHECK(wheel.reschedule(later, 70000));
+        EDS_CHECK(100 == wheel.nextExpiry());
+
+        expireUntil(wheel, 69999);
+        EDS_CHECK(fired == std::vector<uint64_t>({1}));
+        expireUntil(wheel, 70000);
+        EDS_CHECK(fired == std::vector<uint64_t>({1, 2}));
+        EDS_CHECK(!wheel.reschedule(later, 80000));
+    }
+
+    void randomOperationsMatchAReferenceModel() {
+        std::mt19937_64 random(7);
+        TimingWheel wheel(64, 12345);
+        std::map<TimingWheel::TimerId, uint64_t> pending;      // Reference: id to expiry
+        std::vector<TimingWheel::TimerId> ids;
+        std::vector<TimingWheel::TimerId> fired;
+        uint64_t now = 12345;
+        bool matched = true;
+
+        for (int operation = 0; operation < 50000 && matched; ++operation) {
+            uint64_t expiry = now + random() % (uint64_t{1} << (random() % 40));
+            switch (random() % 8) {
+                case 0: case 1: case 2: {
+                    auto tag = std::make_shared<TimingWheel::TimerId>();
+                    *tag = wheel.schedule(expiry, [&fired, tag] { fired.push_back(*tag); });
+                    pending[*tag] = expiry;
+                    ids.push_back(*tag);
+                    break;
+                }
+                case 3:
+                    if (!ids.empty()) {
+                        TimingWheel::TimerId id = ids[random() % ids.size()];
+                        matched = wheel.cancel(id) == (pending.erase(id) != 0);
+                    }
+                    break;
+                case 4:
+                    if (!ids.empty()) {
+                        TimingWheel::TimerId id = ids[random() % ids.size()];
+                        bool isPending = pending.count(id) != 0;
+                        matched = wheel.reschedule(id, expiry) == isPending;
+                        if (isPending) {
+                            pending[id] = expiry;
+                        }
+                    }
+                    break;
+                default:
+                    now += random() % (uint64_t{1} << (random() % 24));
+                    expireUntil(wheel, now);
+
+                    // Every fired timer was due; every timer due a whole tick ago has fired
+                    for (TimingWheel::TimerId id : fired) {
+                        auto timer = pending.find(id);
+                        matched = matched && timer != pending.end() && timer->second <= now;
+                        if (timer != pending.end()) {
+                            pending.erase(timer);
+                        }
+                    }
+                    fired.clear();
+                    for (const auto& timer : pending) {
+                        matched = matched && timer.second + 64 > now;
+                    }
+                    matched = matched && wheel.size() == pending.size();
+                    break;
+            }
+        }
+
+        EDS_CHECK(matched);
+    }
+}
+
+int main() {
+    timersFireOnTheirTickAndNeverEarly();
+    timersCascadeAcrossLevelBoundaries();
+    aLargeStepFiresEveryTimerInExpiryOrder();
+    cancelledTimersNeverFire();
+    rescheduledTimersMoveBetweenLevels();
+    randomOperationsMatchAReferenceModel();
+
+    return Test::finish("timing_wheel");
+}